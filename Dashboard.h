@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpmcRing.h"
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// Перемальовує консоль ANSI-послідовностями: виводяться лише рядки,
+// що змінилися з попереднього кадру, без очищення екрана.
+class ConsoleFrame {
+public:
+    ConsoleFrame() {
+#ifdef _WIN32
+        // у консолі Windows ANSI-послідовності треба ввімкнути явно
+        HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(out, &mode))
+            SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+    }
+
+    void draw(const std::vector<std::string>& lines) {
+        std::string out;
+        if (first) {
+            out += "\x1b[2J";
+            first = false;
+        }
+        size_t rows = lines.size() > previous.size() ? lines.size() : previous.size();
+        for (size_t i = 0; i < rows; ++i) {
+            const std::string& line = i < lines.size() ? lines[i] : empty;
+            if (i < previous.size() && previous[i] == line) continue;
+            out += "\x1b[" + std::to_string(i + 1) + ";1H" + line + "\x1b[K";
+        }
+        out += "\x1b[" + std::to_string(lines.size() + 1) + ";1H";
+        fwrite(out.data(), 1, out.size(), stdout);
+        fflush(stdout);
+        previous = lines;
+    }
+
+private:
+    std::vector<std::string> previous;
+    const std::string empty;
+    bool first = true;
+};
+
+// Окремий потік інтерфейсу. Робочі потоки лише кладуть події в lock-free
+// канал через publish() і ніколи не чекають на консоль: якщо канал
+// переповнений, подія відкидається й рахується в dropped().
+// Потік інтерфейсу з частотою fps застосовує події до своєї моделі (apply)
+// і малює кадр (render); ConsoleFrame виводить лише змінені рядки, тож
+// render може щокадру читати стан напряму, а не лише з подій.
+// Якщо з минулого кадру були втрачені події, перед apply викликається
+// resync, щоб модель перечитала авторитетний стан.
+template <typename Event>
+class Dashboard {
+public:
+    Dashboard(size_t channelCapacity, int fps,
+              std::function<void(const Event&)> apply,
+              std::function<void(std::vector<std::string>&)> render,
+              std::function<void()> resync = nullptr)
+        : channel(channelCapacity), frameTime(std::chrono::milliseconds(1000 / (fps > 0 ? fps : 1))),
+          apply(std::move(apply)), render(std::move(render)), resync(std::move(resync)) {}
+
+    ~Dashboard() { stop(); }
+
+    void start() {
+        running = true;
+        ui = std::thread([this] { loop(); });
+    }
+
+    // Малює останній кадр і зупиняє потік інтерфейсу.
+    void stop() {
+        if (!ui.joinable()) return;
+        running = false;
+        ui.join();
+    }
+
+    void publish(const Event& event) {
+        if (!channel.try_push(event)) droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long long dropped() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    void loop() {
+        auto next = std::chrono::steady_clock::now();
+        long long seenDropped = 0;
+        bool last = false;
+        while (!last) {
+            last = !running.load();
+            long long lost = dropped();
+            if (lost != seenDropped) {
+                seenDropped = lost;
+                if (resync) resync();
+            }
+            Event event;
+            while (channel.try_pop(event)) apply(event);
+            lines.clear();
+            render(lines);
+            frame.draw(lines);
+            next += frameTime;
+            if (!last) std::this_thread::sleep_until(next);
+        }
+    }
+
+    MpmcRing<Event> channel;
+    std::chrono::steady_clock::duration frameTime;
+    std::function<void(const Event&)> apply;
+    std::function<void(std::vector<std::string>&)> render;
+    std::function<void()> resync;
+    std::atomic<long long> droppedEvents{ 0 };
+    std::atomic<bool> running{ false };
+    std::thread ui;
+    ConsoleFrame frame;
+    std::vector<std::string> lines;
+};
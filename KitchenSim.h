@@ -0,0 +1,324 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+#include "WorkStealing.h"
+#include "Telemetry.h"
+
+// Розподіл інтервалів у секундах.
+struct IntervalDist {
+    enum Kind { Fixed, UniformInt, Uniform, Exponential };
+    Kind kind = UniformInt;
+    double a = 1; // Fixed: значення, Uniform*: мінімум, Exponential: середнє
+    double b = 5; // Uniform*: максимум
+
+    template <typename Rng>
+    double operator()(Rng& rng) const {
+        switch (kind) {
+        case Fixed: return a;
+        case UniformInt: return (double)std::uniform_int_distribution<int>((int)a, (int)b)(rng);
+        case Uniform: return std::uniform_real_distribution<double>(a, b)(rng);
+        case Exponential: return std::exponential_distribution<double>(1.0 / a)(rng);
+        }
+        return a;
+    }
+
+    // "fixed:2", "uniformint:1:5", "uniform:0.5:2", "exp:3"; false при помилці
+    static bool parse(const std::string& text, IntervalDist& out) {
+        size_t c1 = text.find(':');
+        if (c1 == std::string::npos) return false;
+        std::string kind = text.substr(0, c1);
+        size_t c2 = text.find(':', c1 + 1);
+        try {
+            out.a = std::stod(text.substr(c1 + 1, c2 == std::string::npos ? std::string::npos : c2 - c1 - 1));
+            if (c2 != std::string::npos) out.b = std::stod(text.substr(c2 + 1));
+        }
+        catch (...) {
+            return false;
+        }
+        if (kind == "fixed") out.kind = Fixed;
+        else if (kind == "uniformint" && c2 != std::string::npos) out.kind = UniformInt;
+        else if (kind == "uniform" && c2 != std::string::npos) out.kind = Uniform;
+        else if (kind == "exp") out.kind = Exponential;
+        else return false;
+        // у експоненційного розподілу середнє a > 0, інакше інтенсивність 1/a нескінченна
+        if (out.kind == Exponential) return out.a > 0;
+        return out.a >= 0 && (out.kind == Fixed || out.b >= out.a);
+    }
+};
+
+struct SimConfig {
+    int cashiers = 3;
+    int cooks = 4;
+    int queueCapacity = 5;
+    int maxOrders = 20;
+    int maxOrderItems = 3;
+    IntervalDist orderInterval;               // пауза касира між замовленнями
+    std::vector<double> menuCookTime;         // секунди на кожну страву меню
+    IntervalDist cookTimeScale{ IntervalDist::Fixed, 1, 1 }; // множник часу страви
+    uint32_t seed = 1;
+    std::string csvPath;                      // порожньо - без CSV
+    double csvIntervalSec = 1;
+};
+
+// Підсумки прогону; однакові для реального та віртуального часу.
+struct SimulationStats {
+    int completed = 0;
+    int rejected = 0;
+    std::vector<int> cashierOrders;
+    std::vector<int> cookOrders;
+    std::vector<WorkerStats> cookStats;
+    double elapsedSec = 0;
+    TelemetrySnapshot telemetry;
+    bool csvFailed = false; // не вдалося відкрити SimConfig::csvPath
+};
+
+// Дискретно-подієва модель Lab3: та сама обмежена черга, розбиття
+// замовлення на страви та крадіжка страв вільними кухарями, але час
+// віртуальний (мікросекунди) і просувається чергою подій з пріоритетом.
+// Кожен касир має власний генератор з seed + номер, тож при однаковій
+// конфігурації результат однаковий (у межах однієї стандартної бібліотеки).
+class KitchenSim {
+public:
+    explicit KitchenSim(const SimConfig& config) : cfg(config) {}
+
+    SimulationStats run() {
+        reset();
+        for (int c = 0; c < cfg.cashiers; ++c)
+            schedule(toMicros(cfg.orderInterval(cashierRng[c])), CashierTick, c);
+
+        std::ofstream csv;
+        int64_t csvStep = toMicros(cfg.csvIntervalSec);
+        int64_t nextSample = csvStep;
+        if (!cfg.csvPath.empty()) {
+            csv.open(cfg.csvPath);
+            if (csv.is_open()) writeCsvHeader(csv, cfg.cooks);
+            else stats.csvFailed = true;
+        }
+
+        while (!events.empty()) {
+            Event e = events.top();
+            events.pop();
+            // знімки телеметрії на межах інтервалу у віртуальному часі
+            for (; csv.is_open() && csvStep > 0 && nextSample <= e.time; nextSample += csvStep)
+                writeCsvRow(csv, telemetry->snapshot(nextSample));
+            now = e.time;
+            if (e.type == CashierTick) onCashierTick(e.who);
+            else onItemDone(e.who);
+        }
+
+        stats.elapsedSec = now / 1e6;
+        stats.telemetry = telemetry->finalSnapshot(now);
+        if (csv.is_open()) writeCsvRow(csv, telemetry->snapshot(now));
+        return stats;
+    }
+
+private:
+    enum EventType : uint8_t { CashierTick, ItemDone };
+
+    struct Event {
+        int64_t time;
+        uint64_t seq; // порядок додавання розв'язує однаковий час детерміновано
+        EventType type;
+        int who;
+        bool operator>(const Event& o) const {
+            return time != o.time ? time > o.time : seq > o.seq;
+        }
+    };
+
+    struct SimOrder {
+        int cashier;
+        int itemsLeft;
+        int64_t created;
+        int64_t started;
+    };
+
+    struct Cook {
+        std::deque<std::pair<int, int>> tasks; // (слот замовлення, страва)
+        bool busy = false;
+        int order = 0;
+        int64_t startedAt = 0;
+    };
+
+    const SimConfig cfg;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    std::vector<std::mt19937> cashierRng;
+    std::vector<std::mt19937> cookRng;
+    // Пул станів замовлень: живими є лише замовлення в черзі та в роботі,
+    // тож слот звільняється при завершенні чи відмові, і пам'ять не росте з maxOrders.
+    std::vector<SimOrder> orders;
+    std::vector<int> orderItems; // страви слоту s: [s * maxOrderItems, +itemsLeft)
+    std::vector<int> freeSlots;
+    std::vector<int> queue; // кільцевий буфер слотів замовлень
+    size_t queueHead = 0, queueSize = 0;
+    std::vector<Cook> cooks;
+    std::vector<uint64_t> stealRng;
+    SimulationStats stats;
+    int64_t now = 0;
+    uint64_t seq = 0;
+    int nextOrderId = 1;
+    bool done = false;
+    std::unique_ptr<PipelineTelemetry> telemetry;
+
+    static int64_t toMicros(double seconds) { return (int64_t)std::llround(seconds * 1e6); }
+
+    void reset() {
+        events = {};
+        cashierRng.clear();
+        for (int c = 0; c < cfg.cashiers; ++c) cashierRng.emplace_back(cfg.seed + c);
+        cookRng.clear();
+        for (int k = 0; k < cfg.cooks; ++k) cookRng.emplace_back(cfg.seed + cfg.cashiers + k);
+        // у роботі одночасно щонайбільше по два замовлення на кухаря:
+        // страва, яку він готує, і решта страв у його деку
+        orders.clear();
+        orderItems.clear();
+        freeSlots.clear();
+        for (int i = 0; i < cfg.queueCapacity + 2 * cfg.cooks; ++i) freeSlots.push_back(addSlot());
+        queue.assign(cfg.queueCapacity > 0 ? cfg.queueCapacity : 1, 0);
+        queueHead = queueSize = 0;
+        cooks.assign(cfg.cooks, Cook());
+        stealRng.assign(cfg.cooks, 0);
+        for (int k = 0; k < cfg.cooks; ++k) stealRng[k] = 0x9E3779B97F4A7C15ULL * (cfg.seed + k + 1);
+        stats = SimulationStats();
+        stats.cashierOrders.assign(cfg.cashiers, 0);
+        stats.cookOrders.assign(cfg.cooks, 0);
+        stats.cookStats.assign(cfg.cooks, WorkerStats());
+        now = 0;
+        seq = 0;
+        nextOrderId = 1;
+        done = false;
+        telemetry.reset(new PipelineTelemetry(cfg.cooks, cfg.queueCapacity));
+    }
+
+    int addSlot() {
+        orders.push_back(SimOrder{ 0, 0, 0, 0 });
+        orderItems.resize(orderItems.size() + cfg.maxOrderItems);
+        return (int)orders.size() - 1;
+    }
+
+    int acquireSlot() {
+        if (freeSlots.empty()) return addSlot(); // запас на випадок, якщо оцінка пулу занижена
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    void schedule(int64_t at, EventType type, int who) {
+        events.push(Event{ at, seq++, type, who });
+    }
+
+    void onCashierTick(int cashier) {
+        if (done) return;
+        std::mt19937& rng = cashierRng[cashier];
+        int id = nextOrderId++;
+        if (id > cfg.maxOrders) {
+            done = true;
+            return;
+        }
+
+        int items = std::uniform_int_distribution<int>(1, cfg.maxOrderItems)(rng);
+        std::uniform_int_distribution<int> menuDist(0, (int)cfg.menuCookTime.size() - 1);
+        int slot = acquireSlot();
+        orders[slot] = SimOrder{ cashier, items, now, 0 };
+        // страви вибираємо одразу, щоб кількість викликів rng не залежала від кухні
+        int* dishes = &orderItems[(size_t)slot * cfg.maxOrderItems];
+        for (int i = 0; i < items; ++i) dishes[i] = menuDist(rng);
+
+        telemetry->reserve(now);
+        if ((int)queueSize >= cfg.queueCapacity) {
+            stats.rejected++;
+            telemetry->rejected(now);
+            freeSlots.push_back(slot);
+        }
+        else {
+            telemetry->submitted(now);
+            queue[(queueHead + queueSize) % queue.size()] = slot;
+            queueSize++;
+            dispatchIdle();
+        }
+
+        schedule(now + toMicros(cfg.orderInterval(rng)), CashierTick, cashier);
+    }
+
+    void onItemDone(int cook) {
+        Cook& k = cooks[cook];
+        telemetry->busy(cook, now - k.startedAt);
+        k.busy = false;
+
+        SimOrder& o = orders[k.order];
+        if (--o.itemsLeft == 0) {
+            telemetry->served(now - o.started);
+            stats.completed++;
+            stats.cashierOrders[o.cashier]++;
+            stats.cookOrders[cook]++;
+            freeSlots.push_back(k.order);
+        }
+        startNext(cook);
+        dispatchIdle();
+    }
+
+    // Та сама послідовність, що й у WorkStealingScheduler: своя дек, спільна черга, крадіжка.
+    bool startNext(int cook) {
+        Cook& k = cooks[cook];
+        WorkerStats& st = stats.cookStats[cook];
+        if (!k.tasks.empty()) {
+            auto task = k.tasks.back();
+            k.tasks.pop_back();
+            startItem(cook, task.first, task.second);
+            st.tasks++;
+            return true;
+        }
+        if (queueSize > 0) {
+            int slot = queue[queueHead];
+            queueHead = (queueHead + 1) % queue.size();
+            queueSize--;
+            orders[slot].started = now;
+            telemetry->dequeued(now);
+            telemetry->waited(now - orders[slot].created);
+            const int* items = &orderItems[(size_t)slot * cfg.maxOrderItems];
+            for (int i = 1; i < orders[slot].itemsLeft; ++i) k.tasks.emplace_back(slot, items[i]);
+            startItem(cook, slot, items[0]);
+            st.tasks++;
+            return true;
+        }
+        int n = cfg.cooks;
+        if (n > 1) {
+            uint64_t& r = stealRng[cook];
+            r ^= r << 13;
+            r ^= r >> 7;
+            r ^= r << 17;
+            int start = (int)(r % (uint64_t)n);
+            for (int i = 0; i < n; ++i) {
+                int victim = (start + i) % n;
+                if (victim != cook && !cooks[victim].tasks.empty()) {
+                    auto task = cooks[victim].tasks.front();
+                    cooks[victim].tasks.pop_front();
+                    startItem(cook, task.first, task.second);
+                    st.tasks++;
+                    st.steals++;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void dispatchIdle() {
+        for (int c = 0; c < cfg.cooks; ++c)
+            if (!cooks[c].busy) startNext(c);
+    }
+
+    void startItem(int cook, int order, int item) {
+        Cook& k = cooks[cook];
+        k.busy = true;
+        k.order = order;
+        k.startedAt = now;
+        schedule(now + toMicros(cfg.menuCookTime[item] * cfg.cookTimeScale(cookRng[cook])), ItemDone, cook);
+    }
+};
@@ -9,6 +9,7 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include "Reductions.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -30,13 +31,13 @@ string int_to_string(int value) {
 answer find_slow(vector<int>& arr, long long& duration, int num_threads = 1) {
     auto start = high_resolution_clock::now();
 
-    int max_value = *max_element(arr.begin(), arr.end());
-    int count_max = count(arr.begin(), arr.end(), max_value);
+    // максимум і кількість за один прохід замість max_element + count
+    reduce::Extremum<int> found = reduce::maxCount(arr.data(), arr.size());
 
     auto end = high_resolution_clock::now();
     duration = duration_cast<nanoseconds>(end - start).count();
 
-    return answer(max_value, count_max);
+    return answer(found.value, (int)found.count);
 }
 
 answer find_with_mutex(vector<int>& arr, long long& duration, int num_threads) {
@@ -50,17 +51,10 @@ answer find_with_mutex(vector<int>& arr, long long& duration, int num_threads) {
     int global_count = 0;
 
     auto worker = [&](int start_idx, int end_idx) {
-        int local_max = 0;
-        int local_count = 0;
-        for (int i = start_idx; i < end_idx; ++i) {
-            if (arr[i] > local_max) {
-                local_max = arr[i];
-                local_count = 1;
-            }
-            else if (arr[i] == local_max) {
-                local_count++;
-            }
-        }
+        reduce::Extremum<int> local = reduce::maxCount(arr.data() + start_idx, end_idx - start_idx);
+        if (local.count == 0) return;
+        int local_max = local.value;
+        int local_count = (int)local.count;
         lock_guard<mutex> lock(mtx);
         if (local_max > global_max) {
             global_max = local_max;
@@ -137,7 +131,10 @@ answer find_with_atomic(vector<int>& arr, long long& duration, int num_threads)
     return answer(global_max.load(), global_count.load());
 }
 
-void print_results(vector<int>& arr, answer(*find_func)(vector<int>&, long long&, int), const string& method_label, int num_threads) {
+// Функція пошуку - параметр шаблону: find_with_mutex і find_with_atomic
+// отримують різні інстанціації з прямим викликом, а не спільний вказівник.
+template <auto find_func>
+void print_results(vector<int>& arr, const string& method_label, int num_threads) {
     long long duration = 0;
     answer result = find_func(arr, duration, num_threads);
 
@@ -173,22 +170,22 @@ int main() {
             arr[j] = rand() % 1000 + 1;
         }
 
-        print_results(arr, find_slow, "Single-threaded (slow)", 1);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 2);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 4);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 8);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 16);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 32);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 64);
-        print_results(arr, find_with_mutex, "Multi-threaded (mutex)", 128);
-
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 2);
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 4);
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 8);
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 16);
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 32);
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 64);
-        print_results(arr, find_with_atomic, "Multi-threaded (CAS)", 128);
+        print_results<find_slow>(arr, "Single-threaded (slow)", 1);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 2);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 4);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 8);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 16);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 32);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 64);
+        print_results<find_with_mutex>(arr, "Multi-threaded (mutex)", 128);
+
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 2);
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 4);
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 8);
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 16);
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 32);
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 64);
+        print_results<find_with_atomic>(arr, "Multi-threaded (CAS)", 128);
         cout << string(97, '-') << endl;
     }
 
@@ -1,240 +1,429 @@
-#include <queue>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <random>
-#include <condition_variable>
 #include <chrono>
 #include <atomic>
-#include <map>
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <deque>
+#include "OrderStore.h"
+#include "WorkStealing.h"
+#include "KitchenSim.h"
+#include "Dashboard.h"
+#include "Telemetry.h"
+#include <iomanip>
 
 using namespace std;
 using namespace chrono;
 
 const int MAX_QUEUE_SIZE = 5;
 const int MAX_ORDER_ID = 20;
+const int MAX_ORDER_ITEMS = 3;
 
 const vector<string> menu = {
     "Big Mac", "French Fries", "Cheeseburger", "McChicken",
     "Chicken McNuggets", "Filet-O-Fish", "Apple Pie", "McFlurry"
 };
+const vector<double> menuCookTime = { 4, 2, 3, 3, 4, 3, 1, 1 }; // секунди на кожну страву
 const vector<string> cashiers = { "Amy", "Markus", "Jane" };
 const vector<string> cooks = { "John", "Marie", "Paul", "Abby" };
 
+// страви, касир та кухар зберігаються індексами в menu / cashiers / cooks
 struct Order {
-    int id;
-    string name;
-    string cashier;
-    string cook;
-    string status;
+    int id = 0;
+    int items[MAX_ORDER_ITEMS] = {};
+    int itemCount = 0;
+    int cashier = -1;
+    int cook = -1;
+    OrderStatus status = OrderStatus::Pending;
     system_clock::time_point created;
+    system_clock::time_point started; // кухар узяв замовлення в роботу
+};
+
+// задача кухні: item < 0 - ціле замовлення, яке ще треба розбити на страви
+struct KitchenTask {
+    int orderId = 0;
+    int item = -1;
 };
 
-queue<Order> orderQueue;
-vector<Order> rejectedOrders;
-vector<Order> doneOrders;
-mutex mtxQueue, mtxDone, mtxCout;
-condition_variable cvQueue;
+// касири подають замовлення в обмежену чергу, кухарі крадуть страви один в одного
+WorkStealingScheduler<KitchenTask> kitchen((int)cooks.size(), MAX_QUEUE_SIZE);
+OrderStore<Order> orders(MAX_ORDER_ID + 1); // стан усіх замовлень за id
+vector<atomic<int>> itemsLeft(MAX_ORDER_ID + 1); // недоготовані страви замовлення
+
+// статистика ведеться одразу при завершенні замовлення
+vector<atomic<int>> cashierDone(cashiers.size());
+vector<atomic<int>> cookDone(cooks.size());
 atomic<int> orderId{ 1 };
 atomic<bool> simulationDone{ false };
 
-random_device rd;
-mt19937 gen(rd());
-uniform_int_distribution<> menuDist(0, menu.size() - 1);
-uniform_int_distribution<> cookInterval(5, 10);
-uniform_int_distribution<> processInterval(5, 10);
-uniform_int_distribution<> orderInterval{ 1, 5 };
+// параметри прогону; у реальному часі кількість касирів/кухарів фіксована
+SimConfig config;
+vector<mt19937> cookRng; // множник часу страви; кожен кухар бере лише свій генератор
 
 atomic<int> totalThreadsCreated{ 0 };
 
-vector<steady_clock::time_point> queueFullTimestamps;
-atomic<int> maxQueueDuration{ 0 };
-atomic<int> minQueueDuration{ 100 };
+// телеметрія конвеєра; час у мікросекундах від pipelineStart
+PipelineTelemetry telemetry((int)cooks.size(), MAX_QUEUE_SIZE);
+steady_clock::time_point pipelineStart = steady_clock::now();
 
-void printInterface() {
-    lock_guard<mutex> lock(mtxCout);
-    system("cls");
-    // перевірка роботи випадкового присвоєння часових інтервалів
-    // cout << "cookInterval =" << orderInterval(gen) << endl;
-    // cout << "processInterval =" << processInterval(gen) << endl;
-    // cout << "orderInterval =" << orderInterval(gen) << endl;
+int64_t telemetryNow() {
+    return duration_cast<microseconds>(steady_clock::now() - pipelineStart).count();
+}
 
-    // ------------------------ черга замовлень ----------------------
-    cout << "=== Queue ===" << endl;
-    {
-        lock_guard<mutex> lock(mtxQueue);
-        queue<Order> temp = orderQueue;
-        int i = 1;
-        while (!temp.empty()) {
-            const auto& o = temp.front();
-            cout << i++ << ") " << o.name << " (ID: " << o.id << ", Cashier: " << o.cashier << ")" << endl;
-            temp.pop();
-        }
-        if (orderQueue.empty()) cout << "(Empty)" << endl;
+int64_t micros(system_clock::duration d) {
+    return duration_cast<microseconds>(d).count();
+}
+
+string orderName(const Order& o) {
+    string name;
+    for (int i = 0; i < o.itemCount; ++i) {
+        if (i > 0) name += " + ";
+        name += menu[o.items[i]];
     }
+    return name;
+}
+
+// ------------------------ інтерфейс ---------------------------------
+// Модель інтерфейсу змінює й малює тільки потік інтерфейсу, тому вона без
+// блокувань. Черга, лічильники та поточні страви щокадру читаються з
+// авторитетного стану (сховище та cookCurrent), тож втрачена подія не
+// може залишити застарілий рядок. Події потрібні лише для історії
+// виконаних/відкинутих; якщо якусь відкинуто, історія перечитується зі сховища.
+struct UiEvent {
+    OrderStatus status = OrderStatus::Done; // Done або Rejected
+    Order order;
+};
+
+const size_t UI_HISTORY = 10; // скільки останніх відкинутих/виконаних показувати
+
+// поточна страва кухаря: id замовлення * 256 + страва, 0 - вільний
+vector<atomic<int>> cookCurrent(cooks.size());
+
+vector<Order> uiPending, uiSnapshot;
+deque<Order> uiRejected, uiCompleted;
+
+void pushHistory(deque<Order>& history, const Order& o) {
+    for (const Order& h : history)
+        if (h.id == o.id) return; // вже підтягнуто під час resync
+    history.push_back(o);
+    if (history.size() > UI_HISTORY) history.pop_front();
+}
+
+void applyUiEvent(const UiEvent& e) {
+    pushHistory(e.status == OrderStatus::Done ? uiCompleted : uiRejected, e.order);
+}
+
+void resyncHistory(OrderStatus status, deque<Order>& history) {
+    orders.snapshot(status, uiSnapshot);
+    history.clear();
+    size_t from = uiSnapshot.size() > UI_HISTORY ? uiSnapshot.size() - UI_HISTORY : 0;
+    history.assign(uiSnapshot.begin() + from, uiSnapshot.end());
+}
+
+void resyncUi() {
+    resyncHistory(OrderStatus::Done, uiCompleted);
+    resyncHistory(OrderStatus::Rejected, uiRejected);
+}
+
+void renderDashboard(vector<string>& lines) {
+    // ------------------------ черга замовлень ----------------------
+    orders.snapshot(OrderStatus::Pending, uiPending);
+    lines.push_back("=== Queue ===");
+    int i = 1;
+    for (const auto& o : uiPending)
+        lines.push_back(to_string(i++) + ") " + orderName(o) + " (ID: " + to_string(o.id) + ", Cashier: " + cashiers[o.cashier] + ")");
+    if (uiPending.empty()) lines.push_back("(Empty)");
     // -------------------------------------------------------------
 
 
     // ------------------------ відкинуті замовлення ---------------
-    if (!rejectedOrders.empty()) {
-        cout << "\n--- Rejected Orders ---" << endl;
-        for (const auto& o : rejectedOrders)
-            cout << o.name << " (rejected by " << o.cashier << ")" << endl;
+    int rejectedTotal = orders.count(OrderStatus::Rejected);
+    if (rejectedTotal > 0) {
+        lines.push_back("");
+        lines.push_back("--- Rejected Orders (" + to_string(rejectedTotal) + ") ---");
+        for (const auto& o : uiRejected)
+            lines.push_back(orderName(o) + " (rejected by " + cashiers[o.cashier] + ")");
     }
     // -------------------------------------------------------------
 
 
     // ---------------------- робота на кухні ----------------------
-    cout << "\n=== Kitchen In-Progress ===" << endl;
-    for (const auto& cook : cooks) {
-        cout << cook << ":\t";
-        bool found = false;
-        for (const auto& o : doneOrders)
-            if (o.cook == cook && o.status == "in process") {
-                cout << o.name << " (ID: " << o.id << ")";
-                found = true;
-                break;
-            }
-        if (!found) cout << "(free)";
-        cout << endl;
+    lines.push_back("");
+    lines.push_back("=== Kitchen In-Progress ===");
+    for (size_t c = 0; c < cooks.size(); ++c) {
+        int cur = cookCurrent[c].load(memory_order_relaxed);
+        lines.push_back(cooks[c] + ":\t" + (cur != 0 ? menu[cur % 256] + " (ID: " + to_string(cur / 256) + ")" : string("(free)")));
     }
     // -------------------------------------------------------------
 
 
     // ---------------------- виконані замовлення -------------------
-    cout << "\n=== Completed Orders ===" << endl;
-    for (const auto& o : doneOrders)
-        if (o.status == "done")
-            cout << "ID: " << o.id << " | " << o.name << " | Cashier: " << o.cashier << " | Cook: " << o.cook << endl;
+    lines.push_back("");
+    lines.push_back("=== Completed Orders (" + to_string(orders.count(OrderStatus::Done)) + ") ===");
+    for (const auto& o : uiCompleted)
+        lines.push_back("ID: " + to_string(o.id) + " | " + orderName(o) + " | Cashier: " + cashiers[o.cashier] + " | Cook: " + cooks[o.cook]);
     // -------------------------------------------------------------
-    cout << endl;
 }
 
-void cashierThread(const string& cashierName) {
+Dashboard<UiEvent> dashboard(1024, 10, applyUiEvent, renderDashboard, resyncUi); // 10 кадрів/с
+// -------------------------------------------------------------------
+
+void cashierThread(int cashier) {
     totalThreadsCreated++;
+    mt19937 rng(config.seed + cashier); // власний генератор: без гонок і відтворювано
+    uniform_int_distribution<> menuDist(0, (int)menu.size() - 1);
+    uniform_int_distribution<> itemsDist(1, config.maxOrderItems);
     while (!simulationDone) {
-        this_thread::sleep_for(seconds(orderInterval(gen)));
+        this_thread::sleep_for(duration<double>(config.orderInterval(rng)));
 
         Order order;
-        order.name = menu[menuDist(gen)];
-        order.cashier = cashierName;
+        order.itemCount = itemsDist(rng);
+        for (int i = 0; i < order.itemCount; ++i)
+            order.items[i] = menuDist(rng);
+        order.cashier = cashier;
         order.created = system_clock::now();
 
         int newId = orderId++;
         if (newId > MAX_ORDER_ID) {
             simulationDone = true;
-            cvQueue.notify_all();
             break;
         }
 
         order.id = newId;
-        order.status = "pending";
-
-        {
-            lock_guard<mutex> lock(mtxQueue);
-            if (orderQueue.size() >= MAX_QUEUE_SIZE) {
-                rejectedOrders.push_back(order);
-                auto now = steady_clock::now();
-                queueFullTimestamps.push_back(now);
-
-                if (queueFullTimestamps.size() > 1) {
-                    int duration = duration_cast<milliseconds>(now - queueFullTimestamps[queueFullTimestamps.size() - 2]).count();
-                    maxQueueDuration = max(maxQueueDuration.load(), duration);
-                    minQueueDuration = min(minQueueDuration.load(), duration);
-                }
-            }
-            else {
-                orderQueue.push(order);
-                cvQueue.notify_one();
-            }
+        order.status = OrderStatus::Pending;
+        orders.insert(order); // до push, щоб кухар не взяв замовлення раніше, ніж воно з'явиться в сховищі
+
+        // повна черга - це просто невдалий неблокуючий push;
+        // місце в телеметрії займаємо до push, бо кухар може взяти замовлення одразу
+        int64_t now = telemetryNow();
+        telemetry.reserve(now);
+        if (!kitchen.trySubmit({ order.id, -1 })) {
+            orders.setStatus(order.id, OrderStatus::Rejected);
+            dashboard.publish({ OrderStatus::Rejected, order });
+            telemetry.rejected(now);
+        }
+        else {
+            telemetry.submitted(now);
         }
-        printInterface();
     }
 }
 
-void cookThread(const string& cookName) {
+void cookItem(int cook, const KitchenTask& task) {
+    cookCurrent[cook].store(task.orderId * 256 + task.item, memory_order_relaxed);
+
+    auto begin = steady_clock::now();
+    this_thread::sleep_for(duration<double>(config.menuCookTime[task.item] * config.cookTimeScale(cookRng[cook])));
+    telemetry.busy(cook, duration_cast<microseconds>(steady_clock::now() - begin).count());
+
+    cookCurrent[cook].store(0, memory_order_relaxed);
+    // замовлення готове, коли доготовано останню страву
+    if (--itemsLeft[task.orderId] == 0) {
+        Order order;
+        orders.update(task.orderId, OrderStatus::Done, [cook, &order](Order& o) {
+            o.cook = cook;
+            order = o;
+            });
+        telemetry.served(micros(system_clock::now() - order.started));
+        cashierDone[order.cashier]++;
+        cookDone[cook]++;
+        dashboard.publish({ OrderStatus::Done, order });
+    }
+}
+
+void cookTask(int cook, const KitchenTask& task) {
+    if (task.item >= 0) {
+        cookItem(cook, task);
+        return;
+    }
+
+    // розбиваємо замовлення: першу страву готуємо самі, решту можуть вкрасти інші кухарі
+    Order order;
+    telemetry.dequeued(telemetryNow());
+    orders.update(task.orderId, OrderStatus::InProcess, [&order](Order& o) {
+        o.started = system_clock::now();
+        order = o;
+        });
+    telemetry.waited(micros(order.started - order.created));
+    itemsLeft[order.id] = order.itemCount;
+    for (int i = 1; i < order.itemCount; ++i)
+        kitchen.spawn(cook, { order.id, order.items[i] });
+    cookItem(cook, { order.id, order.items[0] });
+}
+
+void cookThread(int cook) {
     totalThreadsCreated++;
-    while (true) {
-        unique_lock<mutex> lock(mtxQueue);
-        cvQueue.wait(lock, [] { return !orderQueue.empty() || simulationDone; });
-
-        if (simulationDone && orderQueue.empty())
-            return;
-
-        Order order = orderQueue.front();
-        orderQueue.pop();
-        order.cook = cookName;
-        order.status = "in process";
-        {
-            lock_guard<mutex> doneLock(mtxDone);
-            doneOrders.push_back(order);
-        }
+    kitchen.run(cook, [cook](const KitchenTask& task) { cookTask(cook, task); });
+}
+
+string workerName(const vector<string>& names, const string& role, int i) {
+    return i < (int)names.size() ? names[i] : role + " " + to_string(i + 1);
+}
+
+void printStatistics(const SimulationStats& st) {
+    ios oldState(nullptr);
+    oldState.copyfmt(cout);
+    cout << "\n=== Simulation completed. Final statistics ===" << endl;
+    cout << "Total completed orders: " << st.completed << endl;
+    cout << "Rejected orders: " << st.rejected << endl;
+
+    // ------------------------- Статистика опрацьованих засовлень робітниками ------------------
+    cout << "\n=== Cashier Statistics ===" << endl;
+    for (size_t i = 0; i < st.cashierOrders.size(); ++i) // виводимо на екран ім’я касира та кількість замовлень
+        cout << workerName(cashiers, "Cashier", (int)i) << ": " << st.cashierOrders[i] << " orders" << endl;
+
+    const TelemetrySnapshot& t = st.telemetry;
+    cout << "\n=== Cook Statistics ===" << endl;
+    for (size_t i = 0; i < st.cookOrders.size(); ++i) {
+        const WorkerStats& w = st.cookStats[i];
+        double busy = i < t.busySec.size() ? t.busySec[i] : 0;
+        cout << workerName(cooks, "Cook", (int)i) << ": " << st.cookOrders[i] << " orders, "
+            << w.tasks << " tasks, " << w.steals << " stolen, "
+            << fixed << setprecision(1) << busy << " s busy, " << max(0.0, st.elapsedSec - busy) << " s idle ("
+            << (int)(st.elapsedSec > 0 ? 100.0 * busy / st.elapsedSec : 0) << "% busy)" << endl;
+    }
+    // ---------------------------------------------------------------------------------------
+
+
+    // ---------------------- Телеметрія черги ----------------------------------------------
+    cout << "\n=== Queue Telemetry ===" << endl;
+    cout << "Accepted / rejected: " << t.submitted << " / " << t.rejected << endl;
+    cout << "Reject rate at last order (1s / 10s / 60s): " << setprecision(1) << 100 * t.rejectRate1s << "% / "
+        << 100 * t.rejectRate10s << "% / " << 100 * t.rejectRate60s << "%" << endl;
+    cout << "Average queue depth: " << setprecision(2) << t.avgDepth << endl;
+    cout << "Total time queue was full: " << setprecision(1) << t.fullSec << " s" << endl;
+
+    cout << "\n=== Order Latency (ms) ===" << endl;
+    cout << left << setw(22) << "" << setw(10) << "count" << setw(10) << "p50" << setw(10) << "p90"
+        << setw(10) << "p99" << setw(10) << "max" << endl;
+    for (auto row : { make_pair("Queue -> cooking", &t.wait), make_pair("Cooking -> done", &t.service) })
+        cout << setw(22) << row.first << setw(10) << row.second->count << setw(10) << row.second->p50Ms
+            << setw(10) << row.second->p90Ms << setw(10) << row.second->p99Ms << setw(10) << row.second->maxMs << endl;
+    cout.copyfmt(oldState);
+    // ----------------------------------------------------------------------------------------
+}
+
+// Віртуальний час: та сама модель без сну та виводу, для планування потужностей.
+void runVirtual() {
+    auto start = steady_clock::now();
+    SimulationStats st = KitchenSim(config).run();
+    double wall = duration<double>(steady_clock::now() - start).count();
+    if (st.csvFailed)
+        cerr << "Cannot open " << config.csvPath << endl;
+
+    printStatistics(st);
+    cout << "\nVirtual time: " << st.elapsedSec << " s" << endl;
+    cout << "Wall time: " << wall << " s (" << (wall > 0 ? (long long)(config.maxOrders / wall) : 0) << " orders/s)" << endl;
+}
+
+void printUsage() {
+    cout << "Usage: Lab3 [--virtual] [--orders N] [--cashiers N] [--cooks N] [--queue N]\n"
+        << "            [--items N] [--interval fixed:S|uniformint:A:B|uniform:A:B|exp:MEAN] [--seed S]\n"
+        << "            [--cook-time fixed:K|uniformint:A:B|uniform:A:B|exp:MEAN] [--csv FILE] [--csv-interval SEC]\n"
+        << "--cook-time scales the menu cook time of every dish (fixed:1).\n"
+        << "Without --virtual runs in real time with 3 cashiers and 4 cooks.\n";
+}
 
-        lock.unlock();
-        printInterface();
-        this_thread::sleep_for(seconds(cookInterval(gen)));
-        {
-            lock_guard<mutex> doneLock(mtxDone);
-            for (auto& o : doneOrders)
-                if (o.id == order.id)
-                    o.status = "done";
+bool parseArgs(int argc, char* argv[], bool& virtualTime) {
+    for (int i = 1; i < argc; ++i) {
+        string key = argv[i];
+        if (key == "--virtual") {
+            virtualTime = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        string value = argv[++i];
+        try {
+            if (key == "--orders") config.maxOrders = stoi(value);
+            else if (key == "--cashiers") config.cashiers = stoi(value);
+            else if (key == "--cooks") config.cooks = stoi(value);
+            else if (key == "--queue") config.queueCapacity = stoi(value);
+            else if (key == "--items") config.maxOrderItems = stoi(value);
+            else if (key == "--seed") config.seed = (uint32_t)stoul(value);
+            else if (key == "--csv") config.csvPath = value;
+            else if (key == "--csv-interval") config.csvIntervalSec = stod(value);
+            else if (key == "--interval") {
+                if (!IntervalDist::parse(value, config.orderInterval)) return false;
+            }
+            else if (key == "--cook-time") {
+                if (!IntervalDist::parse(value, config.cookTimeScale)) return false;
+            }
+            else return false;
+        }
+        catch (...) {
+            return false;
         }
-        printInterface();
     }
+    if (config.csvIntervalSec <= 0) return false;
+    if (config.maxOrders < 0 || config.cashiers <= 0 || config.cooks <= 0 || config.queueCapacity <= 0 || config.maxOrderItems <= 0)
+        return false;
+    if (!virtualTime && (config.cashiers != (int)cashiers.size() || config.cooks != (int)cooks.size()
+        || config.queueCapacity != MAX_QUEUE_SIZE || config.maxOrders != MAX_ORDER_ID || config.maxOrderItems > MAX_ORDER_ITEMS))
+        return false; // реальний режим зібраний під фіксовану конфігурацію
+    return true;
 }
 
-int main() {
-    srand(time(nullptr));
+int main(int argc, char* argv[]) {
+    config.cashiers = (int)cashiers.size();
+    config.cooks = (int)cooks.size();
+    config.queueCapacity = MAX_QUEUE_SIZE;
+    config.maxOrders = MAX_ORDER_ID;
+    config.maxOrderItems = MAX_ORDER_ITEMS;
+    config.menuCookTime = menuCookTime;
+    config.seed = random_device{}();
+
+    bool virtualTime = false;
+    if (!parseArgs(argc, argv, virtualTime)) {
+        printUsage();
+        return 1;
+    }
+    if (virtualTime) {
+        runVirtual();
+        return 0;
+    }
+
     int cashiersNum = 3;
     int cookNum = 4;
+    for (int i = 0; i < cookNum; ++i) cookRng.emplace_back(config.seed + cashiersNum + i); // як у KitchenSim
 
     thread cashierThreads[3], cookThreads[4]; // створення масву потоків робітників
     // ------------------------- Статистика опрацьованих засовлень робітниками ------------------
 
 
+    pipelineStart = steady_clock::now();
+    TelemetrySampler sampler(telemetry, pipelineStart);
+    if (!config.csvPath.empty() && !sampler.begin(config.csvPath, milliseconds((long long)(config.csvIntervalSec * 1000))))
+        cerr << "Cannot open " << config.csvPath << endl;
+    dashboard.start();
     for (int i = 0; i < cashiersNum; ++i)
-        cashierThreads[i] = thread(cashierThread, cashiers[i]); // створення потоків касирів
+        cashierThreads[i] = thread(cashierThread, i); // створення потоків касирів
 
     for (int i = 0; i < cookNum; ++i)
-        cookThreads[i] = thread(cookThread, cooks[i]); // створення потоків кухарів
+        cookThreads[i] = thread(cookThread, i); // створення потоків кухарів
 
     for (auto& t : cashierThreads) t.join(); // очікування завершення роботи касирів
+    kitchen.shutdown(); // нових замовлень не буде, кухарі доробляють залишок
     for (auto& t : cookThreads) t.join(); // очікування завершення роботи кухарів
-
-    cout << "\n=== Simulation completed. Final statistics ===" << endl;
-    int totalDone = count_if(doneOrders.begin(), doneOrders.end(), [](const Order& o) {
-        return o.status == "done";
-        });
-    cout << "Total completed orders: " << totalDone << endl;
-    cout << "Rejected orders: " << rejectedOrders.size() << endl;
-
-    // ------------------------- Статистика опрацьованих засовлень робітниками ------------------
-    cout << "\n=== Cashier Statistics ===" << endl;
-    map<string, int> cashierStats;
-    for (const auto& o : doneOrders) // перебір усіх завершених замовлень
-        if (o.status == "done")
-            cashierStats[o.cashier]++; // збільшуємо лічильник замовлень для відповідного касира
-    for (const auto& p : cashierStats) // виводимо на екран ім’я касира та кількість замовлень
-        cout << p.first << ": " << p.second << " orders" << endl;
-
-    cout << "\n=== Cook Statistics ===" << endl;
-    map<string, int> cookStats;
-    for (const auto& o : doneOrders)
-        if (o.status == "done")
-            cookStats[o.cook]++;
-    for (const auto& p : cookStats)
-        cout << p.first << ": " << p.second << " orders" << endl;
-    // ---------------------------------------------------------------------------------------
-
-
-    // ---------------------- Статистика заповнення черги ------------------------------------
-    if (maxQueueDuration == 0) minQueueDuration = 0;
-    cout << "\n=== Queue Fill Time Statistics ===" << endl;
-    cout << "Max duration queue was full: " << maxQueueDuration.load() << " milliseconds" << endl;
-    cout << "Min duration queue was full: " << (minQueueDuration.load() == INT_MAX ? 0 : minQueueDuration.load()) << " milliseconds" << endl;
-
-    // ----------------------------------------------------------------------------------------
-    cout << "\nTotal threads created: " << totalThreadsCreated.load() +2 << endl;
+    dashboard.stop(); // останній кадр, далі консоль вільна для статистики
+    sampler.stop();
+
+    SimulationStats st;
+    st.completed = orders.count(OrderStatus::Done);
+    st.rejected = orders.count(OrderStatus::Rejected);
+    for (size_t i = 0; i < cashiers.size(); ++i) st.cashierOrders.push_back(cashierDone[i].load());
+    for (size_t i = 0; i < cooks.size(); ++i) {
+        st.cookOrders.push_back(cookDone[i].load());
+        st.cookStats.push_back(kitchen.stats((int)i));
+    }
+    int64_t end = telemetryNow();
+    st.elapsedSec = end / 1e6;
+    st.telemetry = telemetry.finalSnapshot(end);
+    printStatistics(st);
+    if (dashboard.dropped() > 0)
+        cout << "\nDashboard events dropped: " << dashboard.dropped() << endl;
+
+    cout << "\nTotal threads created: " << totalThreadsCreated.load() + 3 << endl; // + потік інтерфейсу
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
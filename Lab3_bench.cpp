@@ -0,0 +1,275 @@
+#include <iostream>
+#include <iomanip>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <random>
+#include "MpmcRing.h"
+#include "WorkStealing.h"
+
+using namespace std;
+using namespace chrono;
+
+// Порівняння черги замовлень Lab3 (std::queue + mutex + condition_variable)
+// з lock-free MpmcRing на тому ж сценарії виробник/споживач,
+// а також кухні з однією спільною чергою проти планувальника з крадіжкою роботи.
+
+const int ITEMS = 1000000;
+const int KITCHEN_ORDERS = 20000;
+const int KITCHEN_CAPACITY = 64;
+const int MAX_ORDER_ITEMS = 3;
+const int itemCostUs[] = { 40, 20, 30, 30, 40, 30, 10, 10 }; // "час готування" страв
+
+// Базовий варіант: та сама схема, що була в Lab3.cpp, але з блокуванням на повній черзі
+class LockedQueue {
+public:
+    explicit LockedQueue(size_t capacity) : cap(capacity) {}
+
+    void push(int value) {
+        unique_lock<mutex> lock(mtx);
+        cvNotFull.wait(lock, [&] { return q.size() < cap; });
+        q.push(value);
+        cvNotEmpty.notify_one();
+    }
+
+    bool pop(int& out) {
+        unique_lock<mutex> lock(mtx);
+        cvNotEmpty.wait(lock, [&] { return !q.empty() || closed; });
+        if (q.empty()) return false;
+        out = q.front();
+        q.pop();
+        cvNotFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> lock(mtx);
+        closed = true;
+        cvNotEmpty.notify_all();
+    }
+
+private:
+    queue<int> q;
+    size_t cap;
+    bool closed = false;
+    mutex mtx;
+    condition_variable cvNotEmpty, cvNotFull;
+};
+
+template <typename Queue>
+long long run(Queue& q, int producers, int consumers, long long& checksum) {
+    vector<thread> threads;
+    atomic<long long> total{ 0 };
+
+    auto start = high_resolution_clock::now();
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&] {
+            long long local = 0;
+            int value;
+            while (q.pop(value)) local += value;
+            total += local;
+        });
+
+    vector<thread> producerThreads;
+    for (int p = 0; p < producers; ++p)
+        producerThreads.emplace_back([&, p] {
+            for (int i = p; i < ITEMS; i += producers) q.push(i);
+        });
+
+    for (auto& t : producerThreads) t.join();
+    q.close();
+    for (auto& t : threads) t.join();
+    auto end = high_resolution_clock::now();
+
+    checksum = total.load();
+    return duration_cast<nanoseconds>(end - start).count();
+}
+
+void print_results(int producers, int consumers, size_t capacity, long long duration, long long checksum, const string& label) {
+    cout << left
+        << setw(12) << producers
+        << setw(12) << consumers
+        << setw(12) << capacity
+        << setw(20) << duration
+        << setw(18) << fixed << setprecision(0) << ITEMS / (duration / 1e9)
+        << setw(25) << label
+        << (checksum == (long long)ITEMS * (ITEMS - 1) / 2 ? "" : "CHECKSUM MISMATCH")
+        << endl;
+}
+
+// ------------------------ кухня ----------------------------------
+struct SimOrder {
+    int items[MAX_ORDER_ITEMS];
+    int itemCount;
+};
+
+struct SimTask {
+    int order = 0;
+    int item = -1; // -1 - ціле замовлення
+};
+
+vector<SimOrder> makeOrders() {
+    mt19937 gen(42);
+    uniform_int_distribution<> countDist(1, MAX_ORDER_ITEMS);
+    uniform_int_distribution<> itemDist(0, 7);
+    vector<SimOrder> orders(KITCHEN_ORDERS);
+    for (auto& o : orders) {
+        o.itemCount = countDist(gen);
+        for (int i = 0; i < o.itemCount; ++i) o.items[i] = itemDist(gen);
+    }
+    return orders;
+}
+
+void cookFor(int item) {
+    auto until = steady_clock::now() + microseconds(itemCostUs[item]);
+    while (steady_clock::now() < until) {}
+}
+
+struct KitchenResult {
+    long long duration = 0;
+    vector<WorkerStats> workers;
+    vector<long long> busyNs; // час готування кожного кухаря
+};
+
+template <typename Submit>
+void submitAll(const vector<SimOrder>& orders, int producers, Submit&& submit) {
+    vector<thread> producerThreads;
+    for (int p = 0; p < producers; ++p)
+        producerThreads.emplace_back([&, p] {
+            for (int i = p; i < (int)orders.size(); i += producers)
+                while (!submit(i)) this_thread::yield();
+        });
+    for (auto& t : producerThreads) t.join();
+}
+
+// модель Lab3 до змін: кожен кухар бере ціле замовлення зі спільної черги
+KitchenResult runSingleQueue(const vector<SimOrder>& orders, int producers, int cooks) {
+    MpmcRing<int> q(KITCHEN_CAPACITY);
+    KitchenResult result;
+    result.workers.resize(cooks);
+    result.busyNs.assign(cooks, 0);
+    vector<thread> threads;
+
+    auto start = high_resolution_clock::now();
+    for (int c = 0; c < cooks; ++c)
+        threads.emplace_back([&, c] {
+            int id;
+            while (q.pop(id)) {
+                auto begin = steady_clock::now();
+                for (int i = 0; i < orders[id].itemCount; ++i) cookFor(orders[id].items[i]);
+                result.workers[c].tasks++;
+                result.busyNs[c] += duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+            }
+        });
+    submitAll(orders, producers, [&](int id) { return q.try_push(id); });
+    q.close();
+    for (auto& t : threads) t.join();
+    result.duration = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+    return result;
+}
+
+// замовлення розбивається на страви, вільні кухарі крадуть їх у зайнятих
+KitchenResult runWorkStealing(const vector<SimOrder>& orders, int producers, int cooks) {
+    WorkStealingScheduler<SimTask> kitchen(cooks, KITCHEN_CAPACITY);
+    KitchenResult result;
+    result.busyNs.assign(cooks, 0);
+    vector<thread> threads;
+
+    auto start = high_resolution_clock::now();
+    for (int c = 0; c < cooks; ++c)
+        threads.emplace_back([&, c] {
+            kitchen.run(c, [&, c](const SimTask& task) {
+                auto begin = steady_clock::now();
+                if (task.item >= 0) {
+                    cookFor(task.item);
+                }
+                else {
+                    const SimOrder& o = orders[task.order];
+                    for (int i = 1; i < o.itemCount; ++i) kitchen.spawn(c, { task.order, o.items[i] });
+                    cookFor(o.items[0]);
+                }
+                result.busyNs[c] += duration_cast<nanoseconds>(steady_clock::now() - begin).count();
+                });
+        });
+    submitAll(orders, producers, [&](int id) { return kitchen.trySubmit({ id, -1 }); });
+    kitchen.shutdown();
+    for (auto& t : threads) t.join();
+    result.duration = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+    for (int c = 0; c < cooks; ++c) result.workers.push_back(kitchen.stats(c));
+    return result;
+}
+
+void print_kitchen(int cooks, const KitchenResult& r, const string& label) {
+    double minUtil = 100, maxUtil = 0;
+    uint64_t steals = 0;
+    for (size_t c = 0; c < r.workers.size(); ++c) {
+        double util = 100.0 * r.busyNs[c] / r.duration;
+        minUtil = min(minUtil, util);
+        maxUtil = max(maxUtil, util);
+        steals += r.workers[c].steals;
+    }
+    cout << left
+        << setw(10) << cooks
+        << setw(20) << r.duration
+        << setw(15) << fixed << setprecision(0) << KITCHEN_ORDERS / (r.duration / 1e9)
+        << setw(12) << setprecision(1) << minUtil
+        << setw(12) << maxUtil
+        << setw(10) << steals
+        << setw(25) << label
+        << endl;
+}
+// -------------------------------------------------------------------
+
+int main() {
+    const int configs[][2] = { {1, 1}, {3, 4}, {4, 4}, {8, 8} };
+    const size_t capacities[] = { 5, 64, 1024 };
+
+    cout << left
+        << setw(12) << "Producers"
+        << setw(12) << "Consumers"
+        << setw(12) << "Capacity"
+        << setw(20) << "Execution Time (ns)"
+        << setw(18) << "Items/s"
+        << setw(25) << "Method" << endl;
+    cout << string(99, '-') << endl;
+
+    for (const auto& cfg : configs) {
+        for (size_t capacity : capacities) {
+            long long checksum = 0;
+            {
+                LockedQueue q(capacity);
+                long long duration = run(q, cfg[0], cfg[1], checksum);
+                print_results(cfg[0], cfg[1], capacity, duration, checksum, "mutex + condvar");
+            }
+            {
+                MpmcRing<int> q(capacity);
+                long long duration = run(q, cfg[0], cfg[1], checksum);
+                print_results(cfg[0], cfg[1], capacity, duration, checksum, "lock-free MPMC ring");
+            }
+        }
+        cout << string(99, '-') << endl;
+    }
+
+    cout << "\n" << left
+        << setw(10) << "Cooks"
+        << setw(20) << "Execution Time (ns)"
+        << setw(15) << "Orders/s"
+        << setw(12) << "Min busy %"
+        << setw(12) << "Max busy %"
+        << setw(10) << "Steals"
+        << setw(25) << "Kitchen model" << endl;
+    cout << string(104, '-') << endl;
+
+    vector<SimOrder> orders = makeOrders();
+    for (int cooks : { 1, 2, 4, 8 }) {
+        print_kitchen(cooks, runSingleQueue(orders, 3, cooks), "single shared queue");
+        print_kitchen(cooks, runWorkStealing(orders, 3, cooks), "work stealing");
+        cout << string(104, '-') << endl;
+    }
+    return 0;
+}
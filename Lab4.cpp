@@ -12,6 +12,8 @@
 #include <cmath>
 #include <mutex>
 #include <algorithm>
+#include <limits>
+#include "Reductions.h"
 using namespace std;
 using namespace std::chrono;
 #pragma comment(lib, "ws2_32.lib")
@@ -19,9 +21,11 @@ using namespace std::chrono;
 #define SERVER_PORT 8080
 #define BUFFER_SIZE 1024
 
+// Протокол: mode -> "Mode received" -> size -> dtype -> [масив] -> threadCount -> Result
+// dtype - значення reduce::DType, масив передається у вигляді сирих байтів цього типу.
 struct Result {
-    float sum;
-    float norm;
+    double sum;
+    double norm;
     long long duration_ns;
 };
 
@@ -30,14 +34,23 @@ void handleError(const char* message) {
     exit(EXIT_FAILURE);
 }
 
-float norm_slow(const vector<int>& arr, float& sum, long long& duration) {
+// Великий масив може прийти кількома частинами, тож читаємо до кінця.
+bool recvAll(SOCKET s, char* data, size_t size) {
+    while (size > 0) {
+        int n = recv(s, data, (int)min<size_t>(size, 1 << 20), 0);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+template <typename T>
+double norm_slow(const vector<T>& arr, double& sum, long long& duration) {
     auto start = high_resolution_clock::now();
 
-    sum = 0;
-    for (int val : arr) {
-        sum += val * val;
-    }
-    float norm = static_cast<float>(sqrt(sum));
+    sum = (double)reduce::sumSquares(arr.data(), arr.size());
+    double norm = sqrt(sum);
 
     auto end = high_resolution_clock::now();
     duration = duration_cast<nanoseconds>(end - start).count();
@@ -45,29 +58,30 @@ float norm_slow(const vector<int>& arr, float& sum, long long& duration) {
     return norm;
 }
 
-void worker(const vector<int>& arr, int start, int step, float& local_sum) {
-    local_sum = 0;
-    for (int i = start; i < (int)arr.size(); i += step) {
-        local_sum += arr[i] * arr[i];
-    }
+template <typename T>
+void worker(const T* arr, size_t begin, size_t end, double& local_sum) {
+    local_sum = (double)reduce::sumSquares(arr + begin, end - begin);
 }
 
-float norm_fast(const vector<int>& arr, int num_threads, float& sum, long long& duration) {
-    vector<float> local_sum(num_threads, 0);
+template <typename T>
+double norm_fast(const vector<T>& arr, int num_threads, double& sum, long long& duration) {
+    vector<double> local_sum(num_threads, 0);
     vector<thread> workers(num_threads);
 
     auto start = high_resolution_clock::now();
     sum = 0;
     for (int i = 0; i < num_threads; ++i) {
-        workers[i] = thread(worker, cref(arr), i, num_threads, ref(local_sum[i]));
+        size_t begin, end;
+        reduce::chunk(arr.size(), num_threads, i, begin, end);
+        workers[i] = thread(worker<T>, arr.data(), begin, end, ref(local_sum[i]));
     }
 
     for (int i = 0; i < num_threads; ++i) {
         workers[i].join();
     }
 
-    sum = accumulate(local_sum.begin(), local_sum.end(), 0.0f);
-    float norm = static_cast<float>(sqrt(sum));
+    sum = accumulate(local_sum.begin(), local_sum.end(), 0.0);
+    double norm = sqrt(sum);
 
     auto end = high_resolution_clock::now();
     duration = duration_cast<nanoseconds>(end - start).count();
@@ -75,6 +89,30 @@ float norm_fast(const vector<int>& arr, int num_threads, float& sum, long long&
     return norm;
 }
 
+// Отримує (mode == 1) або генерує масив типу T, читає threadCount і рахує норму.
+template <typename T>
+bool processArray(SOCKET clientSocket, int mode, int size, int& threadCount, Result& result) {
+    vector<T> array(size);
+    if (mode == 1) {
+        if (!recvAll(clientSocket, (char*)array.data(), array.size() * sizeof(T))) return false;
+    }
+    else {
+        default_random_engine eng((unsigned)time(0));
+        uniform_int_distribution<int> dist(0, numeric_limits<T>::max() < 1000 ? 100 : 1000);
+        for (int i = 0; i < size; ++i) array[i] = (T)dist(eng);
+    }
+
+    if (!recvAll(clientSocket, (char*)&threadCount, sizeof(threadCount))) return false;
+
+    if (threadCount <= 0) {
+        result.norm = norm_slow(array, result.sum, result.duration_ns);
+    }
+    else {
+        result.norm = norm_fast(array, threadCount, result.sum, result.duration_ns);
+    }
+    return true;
+}
+
 void processClient(SOCKET clientSocket) {
     int mode;
     int res = recv(clientSocket, (char*)&mode, sizeof(mode), 0);
@@ -84,61 +122,35 @@ void processClient(SOCKET clientSocket) {
     }
     send(clientSocket, "Mode received", 13, 0);
 
-    vector<int> array;
     int size = 0;
-
-    if (mode == 1) {
-        res = recv(clientSocket, (char*)&size, sizeof(size), 0);
-        if (res <= 0) {
-            closesocket(clientSocket);
-            return;
-        }
-        array.resize(size);
-        res = recv(clientSocket, (char*)array.data(), size * sizeof(int), 0);
-        if (res <= 0) {
-            closesocket(clientSocket);
-            return;
-        }
-    }
-    else {
-        res = recv(clientSocket, (char*)&size, sizeof(size), 0);
-        if (res <= 0) {
-            closesocket(clientSocket);
-            return;
-        }
-        array.resize(size);
-        default_random_engine eng((unsigned)time(0));
-        uniform_int_distribution<int> dist(0, 1000);
-        for (int i = 0; i < size; ++i) array[i] = dist(eng);
-    }
-
-    int threadCount;
-    res = recv(clientSocket, (char*)&threadCount, sizeof(threadCount), 0);
-    if (res <= 0) {
+    int dtype = 0;
+    if (!recvAll(clientSocket, (char*)&size, sizeof(size)) || size < 0 ||
+        !recvAll(clientSocket, (char*)&dtype, sizeof(dtype))) {
         closesocket(clientSocket);
         return;
     }
 
-    float sum = 0;
-    float norm = 0;
-    long long duration_ns = 0;
-
-    if (threadCount <= 0) {
-        norm = norm_slow(array, sum, duration_ns);
-    }
-    else {
-        norm = norm_fast(array, threadCount, sum, duration_ns);
+    // тип елемента стає параметром шаблону, далі працює ядро саме для нього
+    int threadCount = 0;
+    Result result = { 0, 0, 0 };
+    bool ok = false;
+    bool known = reduce::dispatch((reduce::DType)dtype, [&](auto zero) {
+        ok = processArray<decltype(zero)>(clientSocket, mode, size, threadCount, result);
+        });
+    if (!known || !ok) {
+        closesocket(clientSocket);
+        return;
     }
 
-    Result result = { sum, norm, duration_ns };
     send(clientSocket, (char*)&result, sizeof(result), 0);
 
     cout << "\n--- Server Processed Data ---\n";
     cout << "Array size: " << size << "\n";
+    cout << "Element type: " << reduce::dtypeName((reduce::DType)dtype) << "\n";
     cout << "Thread count: " << threadCount << "\n";
-    cout << "Result (sum): " << sum << "\n";
-    cout << "Result (norm): " << norm << "\n";
-    cout << "Time taken (ns): " << duration_ns << "\n";
+    cout << "Result (sum): " << result.sum << "\n";
+    cout << "Result (norm): " << result.norm << "\n";
+    cout << "Time taken (ns): " << result.duration_ns << "\n";
 
     closesocket(clientSocket);
 }
@@ -197,6 +209,25 @@ void startServer() {
     WSACleanup();
 }
 
+// Цілі типи читаються як long long і перевіряються на діапазон T,
+// float32/float64 - як double; false для некоректного чи завеликого значення.
+template <typename T>
+bool readValue(T& out) {
+    if constexpr (is_floating_point<T>::value) {
+        double value;
+        if (!(cin >> value)) return false;
+        if (fabs(value) > numeric_limits<T>::max()) return false;
+        out = (T)value;
+    }
+    else {
+        long long value;
+        if (!(cin >> value)) return false;
+        if (value < (long long)numeric_limits<T>::min() || value > (long long)numeric_limits<T>::max()) return false;
+        out = (T)value;
+    }
+    return true;
+}
+
 void startClient() {
     WSADATA wsaData;
     SOCKET clientSocket;
@@ -234,15 +265,34 @@ void startClient() {
             break;
         }
 
+        int dtype;
+        cout << "Element type: 0 - int8, 1 - int16, 2 - int32, 3 - int64, 4 - float32, 5 - float64: ";
+        cin >> dtype;
+        size_t elementSize = reduce::dtypeSize((reduce::DType)dtype);
+        if (elementSize == 0) {
+            cout << "Wrong type" << endl;
+            closesocket(clientSocket);
+            continue;
+        }
+
         send(clientSocket, (char*)&size, sizeof(size), 0);
+        send(clientSocket, (char*)&dtype, sizeof(dtype), 0);
 
         if (mode == 1) {
-            vector<int> array(size);
-            cout << "Enter " << size << " int values:\n";
-            for (int i = 0; i < size; ++i) {
-                cin >> array[i];
-            }
-            send(clientSocket, (char*)array.data(), size * sizeof(int), 0);
+            vector<char> array(size * elementSize);
+            cout << "Enter " << size << " " << reduce::dtypeName((reduce::DType)dtype) << " values:\n";
+            reduce::dispatch((reduce::DType)dtype, [&](auto zero) {
+                typedef decltype(zero) T;
+                T* values = (T*)array.data();
+                for (int i = 0; i < size; ++i) {
+                    while (!readValue(values[i])) {
+                        cin.clear();
+                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                        cout << "Value " << i + 1 << " is not a valid " << reduce::dtypeName((reduce::DType)dtype) << ", enter it again: ";
+                    }
+                }
+                });
+            send(clientSocket, array.data(), (int)array.size(), 0);
         }
 
         int threadCount;
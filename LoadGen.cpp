@@ -0,0 +1,439 @@
+#ifdef _WIN32
+#define _WINSOCK_DEPRECATED_NO_WARNINGS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+typedef int SOCKET;
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR (-1)
+#define closesocket close
+#endif
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include "LogHistogram.h"
+#include "Reductions.h"
+using namespace std;
+using namespace std::chrono;
+
+// Навантажувальний генератор для HTTP сервера (Lab5) та сервера норми (Lab4).
+// Closed-loop: кожен потік шле наступний запит одразу після відповіді.
+// Open-loop: запити йдуть із заданою частотою, затримка рахується від
+// запланованого моменту відправки (корекція coordinated omission).
+
+struct Config {
+    string target = "http";          // http | norm
+    string host = "127.0.0.1";
+    int port = 8080;
+    int threads = 4;
+    double duration = 10;            // секунди
+    double rate = 0;                 // запитів/с сумарно, 0 = closed-loop
+    vector<string> paths = { "/index.html", "/page2.html", "/404.html" };
+    int normSize = 1000;             // розмір масиву для Lab4
+    int normMode = 0;                // 0 - сервер генерує масив, 1 - шлемо свій
+    int normThreads = 0;             // threadCount у запиті до Lab4
+    reduce::DType normType = reduce::DType::Int32; // тип елементів масиву
+    int timeoutMs = 5000;            // таймаут send/recv, 0 = без таймауту
+    double thinkMs = 0;              // closed-loop: пауза між запитами потоку
+    bool thinkExp = false;           // пауза експоненційна із середнім thinkMs
+};
+
+// Lab4.cpp повертає саме таку структуру
+struct Result {
+    double sum;
+    double norm;
+    long long duration_ns;
+};
+
+// ------------------------ гістограма затримок ----------------------
+// Кошики та правило перцентиля спільні з Telemetry.h (LogHistogram.h).
+class LatencyHistogram {
+public:
+    LatencyHistogram() : counts(loghist::BUCKETS, 0) {}
+
+    void record(long long ns) {
+        if (ns < 0) ns = 0;
+        counts[loghist::bucketIndex((unsigned long long)ns)]++;
+        total++;
+        sum += ns;
+        if (ns > maxValue) maxValue = ns;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+
+    long long percentile(double p) const {
+        return (long long)loghist::percentile(p, total, (uint64_t)maxValue,
+            [this](int i) { return counts[i]; });
+    }
+
+    unsigned long long count() const { return total; }
+    long long max() const { return maxValue; }
+    double mean() const { return total ? (double)sum / total : 0.0; }
+
+private:
+    vector<unsigned long long> counts;
+    unsigned long long total = 0;
+    long long sum = 0;
+    long long maxValue = 0;
+};
+// -------------------------------------------------------------------
+
+struct WorkerStats {
+    LatencyHistogram latency;   // від запланованого моменту (open-loop) або від відправки
+    LatencyHistogram service;   // чистий час обслуговування запиту
+    unsigned long long errors = 0;
+    unsigned long long non2xx = 0;
+    unsigned long long missed = 0; // open-loop: заплановані, але не відправлені до кінця тесту
+};
+
+void handleError(const char* message) {
+    cerr << "Error: " << message << endl;
+    exit(EXIT_FAILURE);
+}
+
+bool sendAll(SOCKET s, const char* data, size_t len) {
+    while (len > 0) {
+        int n = send(s, data, (int)len, 0);
+        if (n <= 0) return false;
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool recvAll(SOCKET s, char* data, size_t len) {
+    while (len > 0) {
+        int n = recv(s, data, (int)len, 0);
+        if (n <= 0) return false;
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+// Таймаут send/recv: сервер, що не відповідає, дає помилку запиту, а не вічне очікування.
+void setTimeout(SOCKET s, int ms) {
+    if (ms <= 0) return;
+#ifdef _WIN32
+    DWORD tv = (DWORD)ms;
+#else
+    timeval tv;
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+#endif
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof(tv));
+    setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char*)&tv, sizeof(tv));
+}
+
+SOCKET connectTo(const sockaddr_in& addr, int timeoutMs) {
+    SOCKET s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET) return INVALID_SOCKET;
+    int flag = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&flag, sizeof(flag));
+    setTimeout(s, timeoutMs);
+    if (connect(s, (const sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR) {
+        closesocket(s);
+        return INVALID_SOCKET;
+    }
+    return s;
+}
+
+// Сервер Lab5 відповідає з "Connection: close", тому читаємо до закриття.
+// Повертає HTTP статус або -1 при помилці.
+int httpRequest(const sockaddr_in& addr, const string& request, int timeoutMs) {
+    SOCKET s = connectTo(addr, timeoutMs);
+    if (s == INVALID_SOCKET) return -1;
+    if (!sendAll(s, request.data(), request.size())) {
+        closesocket(s);
+        return -1;
+    }
+
+    char buffer[4096];
+    string head;
+    int n;
+    while ((n = recv(s, buffer, sizeof(buffer), 0)) > 0) {
+        if (head.size() < 16) head.append(buffer, min<size_t>(n, 16));
+    }
+    closesocket(s);
+
+    if (n < 0 || head.compare(0, 5, "HTTP/") != 0) return -1;
+    size_t sp = head.find(' ');
+    if (sp == string::npos) return -1;
+    return atoi(head.c_str() + sp + 1);
+}
+
+// Протокол Lab4: mode -> "Mode received" -> size -> dtype -> [масив] -> threadCount -> Result
+bool normRequest(const sockaddr_in& addr, const Config& cfg, const vector<char>& data) {
+    SOCKET s = connectTo(addr, cfg.timeoutMs);
+    if (s == INVALID_SOCKET) return false;
+
+    bool ok = sendAll(s, (const char*)&cfg.normMode, sizeof(cfg.normMode));
+    char ack[13];
+    ok = ok && recvAll(s, ack, sizeof(ack));
+    ok = ok && sendAll(s, (const char*)&cfg.normSize, sizeof(cfg.normSize));
+    ok = ok && sendAll(s, (const char*)&cfg.normType, sizeof(cfg.normType));
+    if (ok && cfg.normMode == 1)
+        ok = sendAll(s, data.data(), data.size());
+    ok = ok && sendAll(s, (const char*)&cfg.normThreads, sizeof(cfg.normThreads));
+    Result result;
+    ok = ok && recvAll(s, (char*)&result, sizeof(result));
+
+    closesocket(s);
+    return ok;
+}
+
+void workerThread(int index, const Config& cfg, const sockaddr_in& addr,
+                  steady_clock::time_point start, steady_clock::time_point stop,
+                  WorkerStats& stats) {
+    vector<string> requests;
+    for (const auto& path : cfg.paths)
+        requests.push_back("GET " + path + " HTTP/1.1\r\nHost: " + cfg.host + "\r\nConnection: close\r\n\r\n");
+
+    vector<char> data;
+    if (cfg.target == "norm" && cfg.normMode == 1) {
+        mt19937 eng(index + 1);
+        data.resize(cfg.normSize * reduce::dtypeSize(cfg.normType));
+        reduce::dispatch(cfg.normType, [&](auto zero) {
+            typedef decltype(zero) T;
+            uniform_int_distribution<int> dist(0, numeric_limits<T>::max() < 1000 ? 100 : 1000);
+            T* values = (T*)data.data();
+            for (int i = 0; i < cfg.normSize; ++i) values[i] = (T)dist(eng);
+            });
+    }
+
+    // у open-loop кожен потік отримує свою частку загальної частоти зі зсувом фази
+    bool openLoop = cfg.rate > 0;
+    nanoseconds interval(0);
+    steady_clock::time_point intended = start;
+    if (openLoop) {
+        interval = nanoseconds((long long)(1e9 * cfg.threads / cfg.rate));
+        intended += interval * index / cfg.threads;
+    }
+
+    // think time імітує користувача, що читає відповідь перед наступним запитом
+    mt19937 thinkRng(index + 1);
+    exponential_distribution<double> thinkDist(cfg.thinkMs > 0 ? 1.0 / cfg.thinkMs : 1.0);
+
+    size_t next = index;
+    while (true) {
+        if (openLoop) {
+            if (intended >= stop) break;
+            this_thread::sleep_until(intended);
+        }
+        auto sent = steady_clock::now();
+        if (sent >= stop) {
+            // повільний сервер не розтягує тест: решту розкладу рахуємо пропущеною
+            if (openLoop) stats.missed += (stop - intended + interval - nanoseconds(1)) / interval;
+            break;
+        }
+
+        bool ok;
+        if (cfg.target == "http") {
+            int status = httpRequest(addr, requests[next++ % requests.size()], cfg.timeoutMs);
+            ok = status > 0;
+            if (ok && (status < 200 || status >= 300)) stats.non2xx++;
+        }
+        else {
+            ok = normRequest(addr, cfg, data);
+        }
+
+        auto done = steady_clock::now();
+        // невдалі запити (відмова з'єднання тощо) завершуються миттєво і спотворили б розподіл
+        if (ok) {
+            stats.service.record(duration_cast<nanoseconds>(done - sent).count());
+            stats.latency.record(duration_cast<nanoseconds>(done - (openLoop ? intended : sent)).count());
+        }
+        else {
+            stats.errors++;
+        }
+
+        if (openLoop) intended += interval;
+        else if (cfg.thinkMs > 0) {
+            double ms = cfg.thinkExp ? thinkDist(thinkRng) : cfg.thinkMs;
+            auto wake = steady_clock::now() + nanoseconds((long long)(ms * 1e6));
+            this_thread::sleep_until(wake < stop ? wake : stop);
+        }
+    }
+}
+
+void printUsage() {
+    cout << "Usage: LoadGen <http|norm> [options]\n"
+        << "  --host ADDR        server address (127.0.0.1)\n"
+        << "  --port N           server port (8080)\n"
+        << "  --threads N        load threads (4)\n"
+        << "  --duration SEC     test duration (10)\n"
+        << "  --rate RPS         open-loop total rate, 0 = closed-loop (0)\n"
+        << "  --timeout MS       send/receive timeout, counted as error, 0 = none (5000)\n"
+        << "  --think MS|exp:MS  closed-loop: pause between requests, fixed or exponential (0)\n"
+        << "  --path P           http: request path, repeatable\n"
+        << "  --size N           norm: array size (1000)\n"
+        << "  --mode 0|1         norm: 0 - server generates array, 1 - send array (0)\n"
+        << "  --server-threads N norm: threadCount sent to server (0)\n"
+        << "  --dtype TYPE       norm: int8|int16|int32|int64|float32|float64 (int32)\n";
+}
+
+Config parseArgs(int argc, char* argv[]) {
+    Config cfg;
+    if (argc < 2) {
+        printUsage();
+        exit(EXIT_FAILURE);
+    }
+    cfg.target = argv[1];
+    if (cfg.target != "http" && cfg.target != "norm") {
+        printUsage();
+        exit(EXIT_FAILURE);
+    }
+
+    bool customPaths = false;
+    for (int i = 2; i < argc; ++i) {
+        string key = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            exit(EXIT_FAILURE);
+        }
+        string value = argv[++i];
+        try {
+            if (key == "--host") cfg.host = value;
+            else if (key == "--port") cfg.port = stoi(value);
+            else if (key == "--threads") cfg.threads = stoi(value);
+            else if (key == "--duration") cfg.duration = stod(value);
+            else if (key == "--rate") cfg.rate = stod(value);
+            else if (key == "--timeout") cfg.timeoutMs = stoi(value);
+            else if (key == "--think") {
+                cfg.thinkExp = value.compare(0, 4, "exp:") == 0;
+                cfg.thinkMs = stod(cfg.thinkExp ? value.substr(4) : value);
+            }
+            else if (key == "--size") cfg.normSize = stoi(value);
+            else if (key == "--mode") cfg.normMode = stoi(value);
+            else if (key == "--server-threads") cfg.normThreads = stoi(value);
+            else if (key == "--dtype") {
+                bool found = false;
+                for (int t = 0; t <= (int)reduce::DType::Float64; ++t) {
+                    if (value == reduce::dtypeName((reduce::DType)t)) {
+                        cfg.normType = (reduce::DType)t;
+                        found = true;
+                    }
+                }
+                if (!found) handleError("unknown --dtype");
+            }
+            else if (key == "--path") {
+                if (!customPaths) cfg.paths.clear();
+                customPaths = true;
+                cfg.paths.push_back(value);
+            }
+            else {
+                printUsage();
+                exit(EXIT_FAILURE);
+            }
+        }
+        catch (...) {
+            // stoi/stod кидають на нечисловому значенні або переповненні
+            printUsage();
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (cfg.threads <= 0 || cfg.duration <= 0 || cfg.rate < 0 || cfg.normSize <= 0 || cfg.timeoutMs < 0
+        || cfg.thinkMs < 0 || (cfg.thinkExp && cfg.thinkMs == 0))
+        handleError("invalid option value");
+    return cfg;
+}
+
+void printLatency(const string& label, const LatencyHistogram& h) {
+    cout << left << setw(22) << label
+        << setw(12) << fixed << setprecision(1) << h.mean() / 1000.0
+        << setw(12) << h.percentile(50) / 1000.0
+        << setw(12) << h.percentile(90) / 1000.0
+        << setw(12) << h.percentile(99) / 1000.0
+        << setw(12) << h.percentile(99.9) / 1000.0
+        << setw(12) << h.max() / 1000.0
+        << endl;
+}
+
+int main(int argc, char* argv[]) {
+    Config cfg = parseArgs(argc, argv);
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) handleError("WSAStartup failed");
+#endif
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(cfg.port);
+    if (inet_pton(AF_INET, cfg.host.c_str(), &addr.sin_addr) != 1) handleError("bad host address");
+
+    cout << "Target: " << cfg.target << " " << cfg.host << ":" << cfg.port
+        << " | threads: " << cfg.threads
+        << " | duration: " << cfg.duration << " s"
+        << " | " << (cfg.rate > 0 ? "open-loop " + to_string((long long)cfg.rate) + " req/s" : string("closed-loop"))
+        << (cfg.rate <= 0 && cfg.thinkMs > 0 ? " | think: " + string(cfg.thinkExp ? "exp " : "") + to_string((long long)cfg.thinkMs) + " ms" : string())
+        << endl;
+
+    vector<WorkerStats> stats(cfg.threads);
+    vector<thread> workers;
+    auto start = steady_clock::now() + milliseconds(50);
+    auto stop = start + duration_cast<steady_clock::duration>(duration<double>(cfg.duration));
+
+    for (int i = 0; i < cfg.threads; ++i)
+        workers.emplace_back(workerThread, i, cref(cfg), cref(addr), start, stop, ref(stats[i]));
+    for (auto& t : workers) t.join();
+    auto end = steady_clock::now();
+
+    WorkerStats total;
+    for (const auto& s : stats) {
+        total.latency.merge(s.latency);
+        total.service.merge(s.service);
+        total.errors += s.errors;
+        total.missed += s.missed;
+        total.non2xx += s.non2xx;
+    }
+
+    double elapsed = duration<double>(end - start).count();
+    unsigned long long succeeded = total.latency.count();
+    unsigned long long requests = succeeded + total.errors;
+    cout << "\n=== Load test results ===" << endl;
+    cout << "Requests:   " << requests << endl;
+    cout << "Succeeded:  " << succeeded << endl;
+    cout << "Errors:     " << total.errors << " (" << fixed << setprecision(1)
+        << (requests ? 100.0 * total.errors / requests : 0.0) << "%)" << endl;
+    if (cfg.target == "http") cout << "Non-2xx:    " << total.non2xx << endl;
+    if (cfg.rate > 0) cout << "Missed:     " << total.missed << " (scheduled, not sent before the end)" << endl;
+    cout << "Throughput: " << succeeded / elapsed << " req/s (successful only)" << endl;
+
+    if (succeeded == 0) {
+        cout << "\nNo successful requests, latency not measured" << endl;
+    }
+    else {
+        cout << "\n" << left << setw(22) << "Latency (us)"
+            << setw(12) << "mean" << setw(12) << "p50" << setw(12) << "p90"
+            << setw(12) << "p99" << setw(12) << "p99.9" << setw(12) << "max" << endl;
+        cout << string(94, '-') << endl;
+        printLatency(cfg.rate > 0 ? "Corrected (intended)" : "Response", total.latency);
+        if (cfg.rate > 0) printLatency("Service", total.service);
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return 0;
+}
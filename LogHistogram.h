@@ -0,0 +1,50 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// Лог-лінійні кошики гістограм затримок: значення до 2^SUB_BITS мають власні
+// кошики, далі кожен діапазон [2^k, 2^(k+1)) ділиться на SUB_BUCKETS рівних
+// кошиків (~3% похибка). Спільні для LoadGen (наносекунди) та Telemetry
+// (мікросекунди), щоб перцентилі обох рахувались однаково.
+namespace loghist {
+
+const int SUB_BITS = 5;
+const int SUB_BUCKETS = 1 << SUB_BITS;
+const int BUCKETS = (64 - SUB_BITS) * SUB_BUCKETS;
+
+inline int bucketIndex(uint64_t v) {
+    if (v < SUB_BUCKETS) return (int)v;
+    int msb = 63;
+    while (!(v >> msb)) --msb;
+    int magnitude = msb - SUB_BITS + 1;
+    return magnitude * SUB_BUCKETS + (int)(v >> (magnitude - 1)) - SUB_BUCKETS;
+}
+
+// Найбільше значення, що потрапляє в кошик index.
+inline uint64_t bucketUpper(int index) {
+    int magnitude = index / SUB_BUCKETS;
+    int sub = index % SUB_BUCKETS;
+    if (magnitude == 0) return (uint64_t)sub;
+    return ((uint64_t)(SUB_BUCKETS + sub) << (magnitude - 1)) + (1ULL << (magnitude - 1)) - 1;
+}
+
+// Верхня межа кошика, у який потрапляє p-й перцентиль (ранг ceil(p * n / 100),
+// не менше 1), обрізана до максимуму. countAt(i) повертає кількість у кошику i,
+// тож функція однаково працює зі звичайними та атомарними лічильниками.
+template <typename CountAt>
+uint64_t percentile(double p, uint64_t total, uint64_t maxValue, CountAt countAt) {
+    if (total == 0) return 0;
+    uint64_t rank = (uint64_t)std::ceil(p * (double)total / 100.0);
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += countAt(i);
+        if (seen >= rank) {
+            uint64_t upper = bucketUpper(i);
+            return upper < maxValue ? upper : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+} // namespace loghist
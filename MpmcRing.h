@@ -0,0 +1,198 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <utility>
+
+// Обмежена lock-free MPMC черга (схема Д. Вюкова).
+// Кожна комірка має лічильник послідовності, тому виробники та споживачі
+// синхронізуються лише через CAS на позиціях запису/читання.
+// Лічильник рахує проходи по кільцю: 2 * turn - комірка вільна для запису
+// на проході turn = pos / cap, 2 * turn + 1 - записана. На відміну від
+// лічильника pos / pos + 1 це коректно й для ємності 1.
+// Ознака закриття - старший біт head: після close() CAS виробника на head
+// не проходить, а все, що зайняте раніше, споживачі дочитують.
+// Блокуючі push/pop засинають через std::atomic::wait (futex у Linux,
+// WaitOnAddress у Windows) і тільки коли черга повна/порожня.
+// Потребує C++20.
+template <typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t capacity)
+        : cells(new Cell[capacity ? capacity : 1]), cap(capacity ? capacity : 1) {
+        for (size_t i = 0; i < cap; ++i)
+            cells[i].seq.store(0, std::memory_order_relaxed);
+    }
+
+    ~MpmcRing() {
+        size_t h = head.load(std::memory_order_relaxed) & ~CLOSED;
+        for (size_t pos = tail.load(std::memory_order_relaxed); pos != h; ++pos)
+            cells[pos % cap].ptr()->~T();
+        delete[] cells;
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    // Неблокуючий запис: false, якщо черга повна або закрита.
+    bool try_push(const T& value) { return emplace(value); }
+    bool try_push(T&& value) { return emplace(std::move(value)); }
+
+    // Неблокуюче читання: false, якщо черга порожня.
+    bool try_pop(T& out) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos % cap];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(2 * (pos / cap) + 1);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        T* slot = cell->ptr();
+        out = std::move(*slot);
+        slot->~T();
+        cell->seq.store(2 * (pos / cap + 1), std::memory_order_release);
+        wake(popEpoch, pushWaiters);
+        return true;
+    }
+
+    // Блокуючий запис: чекає на вільне місце; false, якщо черга закрита.
+    bool push(const T& value) {
+        for (int i = 0; i < SPIN_LIMIT; ++i) {
+            if (try_push(value)) return true;
+            std::this_thread::yield();
+        }
+        while (true) {
+            if (try_push(value)) return true;
+            if (isClosed()) return false;
+            pushWaiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint32_t epoch = popEpoch.load();
+            if (try_push(value)) {
+                pushWaiters.fetch_sub(1);
+                return true;
+            }
+            if (!isClosed()) popEpoch.wait(epoch);
+            pushWaiters.fetch_sub(1);
+        }
+    }
+
+    // Блокуюче читання: чекає на елемент; false, якщо черга закрита і порожня.
+    bool pop(T& out) {
+        for (int i = 0; i < SPIN_LIMIT; ++i) {
+            if (try_pop(out)) return true;
+            std::this_thread::yield();
+        }
+        while (true) {
+            if (try_pop(out)) return true;
+            if (isClosed()) return drain(out);
+            popWaiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint32_t epoch = pushEpoch.load();
+            if (try_pop(out)) {
+                popWaiters.fetch_sub(1);
+                return true;
+            }
+            if (!isClosed()) pushEpoch.wait(epoch);
+            popWaiters.fetch_sub(1);
+        }
+    }
+
+    // Після закриття push завжди повертає false, а pop дочитує залишок,
+    // включно з елементами виробників, що встигли зайняти комірку до close().
+    void close() {
+        head.fetch_or(CLOSED);
+        pushEpoch.fetch_add(1);
+        pushEpoch.notify_all();
+        popEpoch.fetch_add(1);
+        popEpoch.notify_all();
+    }
+
+    // Приблизна кількість елементів (точна лише без одночасних операцій).
+    size_t size() const {
+        size_t h = head.load(std::memory_order_relaxed) & ~CLOSED;
+        size_t t = tail.load(std::memory_order_relaxed);
+        return h > t ? (h - t < cap ? h - t : cap) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return cap; }
+    bool isClosed() const { return (head.load() & CLOSED) != 0; }
+
+private:
+    // Скільки разів пробуємо ще до засинання: коротке очікування дешевше за futex.
+    static const int SPIN_LIMIT = 64;
+    static constexpr size_t CLOSED = (size_t)1 << (sizeof(size_t) * 8 - 1);
+
+    struct alignas(64) Cell {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* ptr() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    template <typename U>
+    bool emplace(U&& value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            if (pos & CLOSED) return false; // CAS нижче теж не пройде після close()
+            cell = &cells[pos % cap];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(2 * (pos / cap));
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::forward<U>(value));
+        cell->seq.store(2 * (pos / cap) + 1, std::memory_order_release);
+        wake(pushEpoch, popWaiters);
+        return true;
+    }
+
+    // Черга закрита, тож head більше не росте: дочитуємо до нього, чекаючи
+    // виробників, що зайняли комірку до close(), але ще не записали її.
+    bool drain(T& out) {
+        size_t end = head.load() & ~CLOSED;
+        while (true) {
+            if (try_pop(out)) return true;
+            if (tail.load() >= end) return false;
+            std::this_thread::yield();
+        }
+    }
+
+    // Будимо сплячих лише якщо вони є: без очікувачів це один fence і load.
+    static void wake(std::atomic<uint32_t>& epoch, std::atomic<int>& waiters) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            epoch.fetch_add(1);
+            epoch.notify_one();
+        }
+    }
+
+    Cell* cells;
+    const size_t cap;
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+    alignas(64) std::atomic<uint32_t> pushEpoch{ 0 };
+    std::atomic<int> popWaiters{ 0 };
+    alignas(64) std::atomic<uint32_t> popEpoch{ 0 };
+    std::atomic<int> pushWaiters{ 0 };
+};
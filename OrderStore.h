@@ -0,0 +1,139 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+enum class OrderStatus : uint8_t { Pending, InProcess, Done, Rejected };
+const int ORDER_STATUS_COUNT = 4;
+
+inline const char* toString(OrderStatus status) {
+    switch (status) {
+    case OrderStatus::Pending: return "pending";
+    case OrderStatus::InProcess: return "in process";
+    case OrderStatus::Done: return "done";
+    case OrderStatus::Rejected: return "rejected";
+    }
+    return "unknown";
+}
+
+// Сховище стану замовлень з доступом за id.
+// Слоти індексуються безпосередньо id, а кожен статус має власний
+// інтрузивний двозв'язний список, тому зміна статусу та пошук - O(1),
+// а обхід списку торкається лише замовлень з потрібним статусом.
+// Record повинен мати поля `int id` та `OrderStatus status`.
+template <typename Record>
+class OrderStore {
+public:
+    explicit OrderStore(size_t expectedOrders = 0) {
+        slots.reserve(expectedOrders);
+        for (int s = 0; s < ORDER_STATUS_COUNT; ++s) {
+            head[s] = tail[s] = -1;
+            counts[s].store(0);
+        }
+    }
+
+    // Додає запис у список його статусу; false, якщо id вже зайнятий.
+    bool insert(const Record& record) {
+        if (record.id < 0) return false;
+        std::lock_guard<std::mutex> lock(mtx);
+        if ((size_t)record.id >= slots.size()) slots.resize(record.id + 1);
+        Slot& slot = slots[record.id];
+        if (slot.used) return false;
+        slot.record = record;
+        slot.used = true;
+        link(record.id, record.status);
+        return true;
+    }
+
+    // Переносить запис у список нового статусу та дає змінити інші поля.
+    template <typename Fn>
+    bool update(int id, OrderStatus status, Fn&& mutate) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!contains(id)) return false;
+        Record& record = slots[id].record;
+        mutate(record);
+        if (record.status != status) {
+            unlink(id);
+            record.status = status;
+            link(id, status);
+        }
+        return true;
+    }
+
+    bool setStatus(int id, OrderStatus status) {
+        return update(id, status, [](Record&) {});
+    }
+
+    bool get(int id, Record& out) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!contains(id)) return false;
+        out = slots[id].record;
+        return true;
+    }
+
+    // Копія записів зі статусом status у порядку надходження в статус.
+    // Під блокуванням лише копіювання, яке завдяки спискам торкається
+    // тільки потрібних записів, а не всіх замовлень.
+    void snapshot(OrderStatus status, std::vector<Record>& out) const {
+        out.clear();
+        out.reserve(count(status));
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int id = head[(int)status]; id != -1; id = slots[id].next)
+            out.push_back(slots[id].record);
+    }
+
+    // Обхід знімка: fn викликається без блокування, тож повільний
+    // обробник (наприклад, вивід у консоль) не зупиняє касирів і кухарів.
+    template <typename Fn>
+    void forEach(OrderStatus status, Fn&& fn) const {
+        std::vector<Record> records;
+        snapshot(status, records);
+        for (const Record& record : records) fn(record);
+    }
+
+    // Лічильники оновлюються разом зі списками, тому читаються без блокування.
+    int count(OrderStatus status) const {
+        return counts[(int)status].load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        Record record{};
+        bool used = false;
+        int prev = -1;
+        int next = -1;
+    };
+
+    bool contains(int id) const {
+        return id >= 0 && (size_t)id < slots.size() && slots[id].used;
+    }
+
+    void link(int id, OrderStatus status) {
+        int s = (int)status;
+        Slot& slot = slots[id];
+        slot.prev = tail[s];
+        slot.next = -1;
+        if (tail[s] != -1) slots[tail[s]].next = id;
+        else head[s] = id;
+        tail[s] = id;
+        counts[s].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void unlink(int id) {
+        int s = (int)slots[id].record.status;
+        Slot& slot = slots[id];
+        if (slot.prev != -1) slots[slot.prev].next = slot.next;
+        else head[s] = slot.next;
+        if (slot.next != -1) slots[slot.next].prev = slot.prev;
+        else tail[s] = slot.prev;
+        slot.prev = slot.next = -1;
+        counts[s].fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    std::vector<Slot> slots;
+    int head[ORDER_STATUS_COUNT];
+    int tail[ORDER_STATUS_COUNT];
+    std::atomic<int> counts[ORDER_STATUS_COUNT];
+    mutable std::mutex mtx;
+};
@@ -0,0 +1,268 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Редукції над масивами: сума, норми L1/L2/L∞, скалярний добуток, max/min з
+// кількістю входжень. Усе - шаблони, тож тип елемента (int8..int64, float,
+// double), тип акумулятора та кількість незалежних акумуляторів (Unroll)
+// фіксуються під час компіляції, і компілятор може вбудувати та
+// векторизувати цикл замість виклику через вказівник на функцію.
+namespace reduce {
+
+// Акумулятор за замовчуванням для суми: цілі до int32 - int64_t (точно),
+// int64 і дійсні - double, бо сума двох int64 вже може переповнити int64_t.
+template <typename T>
+using SumAcc = typename std::conditional<std::is_integral<T>::value && sizeof(T) < 8, int64_t, double>::type;
+
+// Для суми квадратів: int8/int16 поміщаються в int64_t, ширші типи - у double.
+template <typename T>
+using SquareAcc = typename std::conditional<std::is_integral<T>::value && sizeof(T) <= 2, int64_t, double>::type;
+
+// Модулі цілих рахуються беззнаково: |INT64_MIN| не вміщується в int64_t.
+// L∞ - це один модуль, тож uint64_t точний; сума модулів int64 може
+// перевищити й uint64_t, тому для неї double.
+template <typename T>
+using LinfAcc = typename std::conditional<std::is_integral<T>::value, uint64_t, double>::type;
+
+template <typename T>
+using L1Acc = typename std::conditional<std::is_integral<T>::value && sizeof(T) < 8, uint64_t, double>::type;
+
+template <typename T>
+struct Extremum {
+    T value;
+    size_t count;
+};
+
+namespace detail {
+
+// Модуль без переповнення: для цілих у беззнаковому типі тієї ж ширини.
+template <typename T>
+using Magnitude = typename std::conditional<std::is_integral<T>::value,
+    std::make_unsigned<T>, std::enable_if<true, T>>::type::type;
+
+template <typename T>
+constexpr Magnitude<T> magnitude(T x) {
+    typedef Magnitude<T> U;
+    return x < 0 ? (U)((U)0 - (U)x) : (U)x;
+}
+
+template <typename Acc>
+struct Plus {
+    static constexpr Acc identity() { return Acc(0); }
+    static constexpr Acc combine(Acc a, Acc b) { return a + b; }
+};
+
+template <typename Acc>
+struct Sum : Plus<Acc> {
+    template <typename T> static constexpr Acc map(T x) { return (Acc)x; }
+};
+
+template <typename Acc>
+struct AbsSum : Plus<Acc> {
+    template <typename T> static constexpr Acc map(T x) { return (Acc)magnitude(x); }
+};
+
+template <typename Acc>
+struct SquareSum : Plus<Acc> {
+    template <typename T> static constexpr Acc map(T x) { return (Acc)x * (Acc)x; }
+};
+
+template <typename Acc>
+struct AbsMax {
+    static constexpr Acc identity() { return Acc(0); }
+    static constexpr Acc combine(Acc a, Acc b) { return a < b ? b : a; }
+    template <typename T> static constexpr Acc map(T x) { return (Acc)magnitude(x); }
+};
+
+// Unroll незалежних акумуляторів розривають ланцюжок залежностей між ітераціями.
+template <typename Op, typename Acc, int Unroll, typename T>
+constexpr Acc run(const T* data, size_t n) {
+    static_assert(Unroll >= 1, "Unroll must be positive");
+    Acc acc[Unroll] = {};
+    for (int k = 0; k < Unroll; ++k) acc[k] = Op::identity();
+
+    size_t i = 0;
+    for (; i + Unroll <= n; i += Unroll)
+        for (int k = 0; k < Unroll; ++k)
+            acc[k] = Op::combine(acc[k], Op::template map<T>(data[i + k]));
+    for (; i < n; ++i)
+        acc[0] = Op::combine(acc[0], Op::template map<T>(data[i]));
+
+    for (int k = 1; k < Unroll; ++k) acc[0] = Op::combine(acc[0], acc[k]);
+    return acc[0];
+}
+
+template <bool Max, typename T>
+constexpr Extremum<T> combineExtremum(Extremum<T> a, Extremum<T> b) {
+    if (a.value == b.value) return { a.value, a.count + b.count };
+    return (Max ? b.value > a.value : b.value < a.value) ? b : a;
+}
+
+template <bool Max, int Unroll, typename T>
+constexpr Extremum<T> extremum(const T* data, size_t n) {
+    static_assert(Unroll >= 1, "Unroll must be positive");
+    const T start = Max ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+    Extremum<T> acc[Unroll] = {};
+    for (int k = 0; k < Unroll; ++k) acc[k] = { start, 0 };
+
+    size_t i = 0;
+    for (; i + Unroll <= n; i += Unroll)
+        for (int k = 0; k < Unroll; ++k)
+            acc[k] = combineExtremum<Max>(acc[k], Extremum<T>{ data[i + k], 1 });
+    for (; i < n; ++i)
+        acc[0] = combineExtremum<Max>(acc[0], Extremum<T>{ data[i], 1 });
+
+    for (int k = 1; k < Unroll; ++k) acc[0] = combineExtremum<Max>(acc[0], acc[k]);
+    return acc[0];
+}
+
+} // namespace detail
+
+template <typename T, typename Acc = SumAcc<T>, int Unroll = 4>
+constexpr Acc sum(const T* data, size_t n) {
+    return detail::run<detail::Sum<Acc>, Acc, Unroll>(data, n);
+}
+
+template <typename T, typename Acc = L1Acc<T>, int Unroll = 4>
+constexpr Acc l1(const T* data, size_t n) {
+    return detail::run<detail::AbsSum<Acc>, Acc, Unroll>(data, n);
+}
+
+template <typename T, typename Acc = SquareAcc<T>, int Unroll = 4>
+constexpr Acc sumSquares(const T* data, size_t n) {
+    return detail::run<detail::SquareSum<Acc>, Acc, Unroll>(data, n);
+}
+
+template <typename T, typename Acc = SquareAcc<T>, int Unroll = 4>
+double l2(const T* data, size_t n) {
+    return std::sqrt((double)sumSquares<T, Acc, Unroll>(data, n));
+}
+
+template <typename T, typename Acc = LinfAcc<T>, int Unroll = 4>
+constexpr Acc linf(const T* data, size_t n) {
+    return detail::run<detail::AbsMax<Acc>, Acc, Unroll>(data, n);
+}
+
+template <typename T, typename Acc = SquareAcc<T>, int Unroll = 4>
+constexpr Acc dot(const T* a, const T* b, size_t n) {
+    Acc acc[Unroll] = {};
+    size_t i = 0;
+    for (; i + Unroll <= n; i += Unroll)
+        for (int k = 0; k < Unroll; ++k)
+            acc[k] += (Acc)a[i + k] * (Acc)b[i + k];
+    for (; i < n; ++i) acc[0] += (Acc)a[i] * (Acc)b[i];
+    for (int k = 1; k < Unroll; ++k) acc[0] += acc[k];
+    return acc[0];
+}
+
+// Максимум і кількість його входжень за один прохід; для n == 0 count == 0.
+template <typename T, int Unroll = 4>
+constexpr Extremum<T> maxCount(const T* data, size_t n) {
+    return detail::extremum<true, Unroll>(data, n);
+}
+
+template <typename T, int Unroll = 4>
+constexpr Extremum<T> minCount(const T* data, size_t n) {
+    return detail::extremum<false, Unroll>(data, n);
+}
+
+// Злиття часткових результатів з різних потоків.
+template <typename T>
+Extremum<T> mergeMax(Extremum<T> a, Extremum<T> b) {
+    if (a.count == 0) return b;
+    if (b.count == 0) return a;
+    return detail::combineExtremum<true>(a, b);
+}
+
+template <typename T>
+Extremum<T> mergeMin(Extremum<T> a, Extremum<T> b) {
+    if (a.count == 0) return b;
+    if (b.count == 0) return a;
+    return detail::combineExtremum<false>(a, b);
+}
+
+namespace detail {
+
+// Крайні значення кожного типу, перевірені під час компіляції:
+// {lowest, max, 0, lowest}, окремо {lowest, max} та {max, max} для суми.
+template <typename T>
+constexpr bool extremesOk() {
+    const T lo = std::numeric_limits<T>::lowest(), hi = std::numeric_limits<T>::max();
+    const T data[] = { lo, hi, 0, lo };
+    const T pair[] = { lo, hi };
+    const T high[] = { hi, hi };
+    const bool integral = std::is_integral<T>::value;
+    // у доповняльному коді |lowest| = max + 1
+    const LinfAcc<T> maxAbs = integral ? (LinfAcc<T>)hi + 1 : (LinfAcc<T>)hi;
+    const L1Acc<T> l1Abs = integral ? (L1Acc<T>)hi + 1 : (L1Acc<T>)hi;
+    const Extremum<T> mx = maxCount(data, 4), mn = minCount(data, 4);
+    return linf(data, 4) == maxAbs
+        && l1(data, 1) == l1Abs
+        && sum(pair, 2) == (SumAcc<T>)lo + (SumAcc<T>)hi
+        && (!integral || sum(high, 2) == (SumAcc<T>)hi + (SumAcc<T>)hi)
+        && (!integral || sumSquares(pair, 2) == (SquareAcc<T>)lo * lo + (SquareAcc<T>)hi * hi)
+        && mx.value == hi && mx.count == 1
+        && mn.value == lo && mn.count == 2;
+}
+
+static_assert(extremesOk<int8_t>(), "int8 extremes");
+static_assert(extremesOk<int16_t>(), "int16 extremes");
+static_assert(extremesOk<int32_t>(), "int32 extremes");
+static_assert(extremesOk<int64_t>(), "int64 extremes");
+static_assert(extremesOk<float>(), "float extremes");
+static_assert(extremesOk<double>(), "double extremes");
+
+} // namespace detail
+
+// Межі i-го з parts суцільних шматків масиву довжини n.
+inline void chunk(size_t n, int parts, int i, size_t& begin, size_t& end) {
+    size_t base = n / parts, extra = n % parts;
+    begin = i * base + ((size_t)i < extra ? i : extra);
+    end = begin + base + ((size_t)i < extra ? 1 : 0);
+}
+
+// Тип елемента в протоколі Lab4.
+enum class DType : int32_t { Int8 = 0, Int16 = 1, Int32 = 2, Int64 = 3, Float32 = 4, Float64 = 5 };
+
+inline size_t dtypeSize(DType t) {
+    switch (t) {
+    case DType::Int8: return 1;
+    case DType::Int16: return 2;
+    case DType::Int32: return 4;
+    case DType::Int64: return 8;
+    case DType::Float32: return 4;
+    case DType::Float64: return 8;
+    }
+    return 0;
+}
+
+inline const char* dtypeName(DType t) {
+    switch (t) {
+    case DType::Int8: return "int8";
+    case DType::Int16: return "int16";
+    case DType::Int32: return "int32";
+    case DType::Int64: return "int64";
+    case DType::Float32: return "float32";
+    case DType::Float64: return "float64";
+    }
+    return "unknown";
+}
+
+// Викликає fn(T{}) з C++-типом, що відповідає dtype; false для невідомого dtype.
+template <typename Fn>
+bool dispatch(DType t, Fn&& fn) {
+    switch (t) {
+    case DType::Int8: fn(int8_t()); return true;
+    case DType::Int16: fn(int16_t()); return true;
+    case DType::Int32: fn(int32_t()); return true;
+    case DType::Int64: fn(int64_t()); return true;
+    case DType::Float32: fn(float()); return true;
+    case DType::Float64: fn(double()); return true;
+    }
+    return false;
+}
+
+} // namespace reduce
@@ -0,0 +1,393 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "LogHistogram.h"
+
+// Гістограма затримок у мікросекундах на атомарних лічильниках
+// з кошиками loghist (LogHistogram.h).
+class AtomicHistogram {
+public:
+    AtomicHistogram() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+    }
+
+    void record(int64_t us) {
+        uint64_t v = us > 0 ? (uint64_t)us : 0;
+        counts[loghist::bucketIndex(v)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        uint64_t prev = maxValue.load(std::memory_order_relaxed);
+        while (v > prev && !maxValue.compare_exchange_weak(prev, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return maxValue.load(std::memory_order_relaxed); }
+
+    uint64_t percentile(double p) const {
+        return loghist::percentile(p, count(), max(),
+            [this](int i) { return counts[i].load(std::memory_order_relaxed); });
+    }
+
+private:
+    std::atomic<uint64_t> counts[loghist::BUCKETS];
+    std::atomic<uint64_t> total{ 0 };
+    std::atomic<uint64_t> maxValue{ 0 };
+};
+
+// Seqlock: читач отримує узгоджену копію T без блокування і повторює спробу,
+// якщо під час копіювання відбувся запис. Записувачів може бути кілька -
+// вони серіалізуються непарним значенням seq. T зберігається 64-бітними
+// словами в relaxed-атомарних, тож одночасне читання не є гонкою даних.
+template <typename T>
+class Seqlocked {
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) % 8 == 0, "T must be trivially copyable 64-bit words");
+public:
+    Seqlocked() { write(T()); }
+
+    template <typename F>
+    void update(F&& f) {
+        uint64_t s = seq.load(std::memory_order_relaxed);
+        for (;;) {
+            if (s & 1) { // інший записувач усередині
+                std::this_thread::yield();
+                s = seq.load(std::memory_order_relaxed);
+            }
+            else if (seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_release); // непарний seq видно раніше за дані
+        T value = read();
+        f(value);
+        write(value);
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        for (;;) {
+            uint64_t before = seq.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            T value = read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) return value;
+        }
+    }
+
+private:
+    static const size_t WORDS = sizeof(T) / 8;
+
+    T read() const {
+        uint64_t w[WORDS];
+        for (size_t i = 0; i < WORDS; ++i) w[i] = words[i].load(std::memory_order_relaxed);
+        T value;
+        std::memcpy(&value, w, sizeof(T));
+        return value;
+    }
+
+    void write(const T& value) {
+        uint64_t w[WORDS];
+        std::memcpy(w, &value, sizeof(T));
+        for (size_t i = 0; i < WORDS; ++i) words[i].store(w[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> seq{ 0 };
+    std::atomic<uint64_t> words[WORDS];
+};
+
+// Глибина черги, зважена за часом, і сумарний час, коли черга була повна.
+// Інтеграл глибини = T * (входи - виходи) - sum(t входу) + sum(t виходу),
+// тож достатньо кількох сум без історії подій.
+// enter() треба викликати до push, а exit() - після pop (або замість
+// невдалого push), тоді лічильник не менший за справжню глибину.
+// Через це він може на мить перевищити місткість, тому повна черга -
+// це перехід через межу cap, а не рівність.
+// Сам клас не синхронізований: кількість і сума мають змінюватись разом,
+// тому PipelineTelemetry тримає його під Seqlocked.
+struct DepthGauge {
+    int64_t cap = 0;
+    int64_t current = 0;
+    int64_t enters = 0, exits = 0;
+    int64_t enterSum = 0, exitSum = 0;
+    int64_t fullEnters = 0, fullExits = 0;
+    int64_t fullEnterSum = 0, fullExitSum = 0;
+
+    void enter(int64_t nowUs) {
+        enters++;
+        enterSum += nowUs;
+        if (current < cap && current + 1 >= cap) { // черга щойно заповнилась
+            fullEnters++;
+            fullEnterSum += nowUs;
+        }
+        current++;
+    }
+
+    void exit(int64_t nowUs) {
+        exits++;
+        exitSum += nowUs;
+        if (current >= cap && current - 1 < cap) { // з повної черги звільнилось місце
+            fullExits++;
+            fullExitSum += nowUs;
+        }
+        current--;
+    }
+
+    int depth() const { return current > 0 ? (int)current : 0; }
+
+    // Середня глибина на проміжку [0, nowUs].
+    double average(int64_t nowUs) const {
+        if (nowUs <= 0) return 0;
+        return integral(nowUs, enters, exits, enterSum, exitSum) / (double)nowUs;
+    }
+
+    double fullSeconds(int64_t nowUs) const {
+        return integral(nowUs, fullEnters, fullExits, fullEnterSum, fullExitSum) / 1e6;
+    }
+
+private:
+    static double integral(int64_t nowUs, int64_t in, int64_t out, int64_t inSum, int64_t outSum) {
+        double v = (double)nowUs * (double)(in - out) - (double)inSum + (double)outSum;
+        return v > 0 ? v : 0;
+    }
+};
+
+// Частка відмов у ковзних вікнах: кільце посекундних кошиків.
+// На межі секунди кошик перевикористовується, тож кілька подій можуть загубитись.
+class SlidingRate {
+public:
+    static const int SECONDS = 60;
+
+    SlidingRate() {
+        for (auto& b : buckets) {
+            b.second.store(-1, std::memory_order_relaxed);
+            b.attempts.store(0, std::memory_order_relaxed);
+            b.rejects.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(int64_t nowUs, bool rejected) {
+        int64_t sec = nowUs / 1000000;
+        Bucket& b = buckets[sec % SECONDS];
+        int64_t seen = b.second.load();
+        if (seen != sec && b.second.compare_exchange_strong(seen, sec)) {
+            b.attempts.store(0);
+            b.rejects.store(0);
+        }
+        b.attempts.fetch_add(1, std::memory_order_relaxed);
+        if (rejected) b.rejects.fetch_add(1, std::memory_order_relaxed);
+        int64_t prev = lastUs.load(std::memory_order_relaxed);
+        while (nowUs > prev && !lastUs.compare_exchange_weak(prev, nowUs, std::memory_order_relaxed)) {}
+    }
+
+    // Час останньої спроби, -1 якщо спроб не було.
+    int64_t last() const { return lastUs.load(std::memory_order_relaxed); }
+
+    // Частка відмов за останні windowSec секунд (включно з поточною).
+    double rate(int64_t nowUs, int windowSec) const {
+        int64_t sec = nowUs / 1000000;
+        uint64_t attempts = 0, rejects = 0;
+        for (const auto& b : buckets) {
+            int64_t s = b.second.load(std::memory_order_relaxed);
+            if (s > sec - windowSec && s <= sec) {
+                attempts += b.attempts.load(std::memory_order_relaxed);
+                rejects += b.rejects.load(std::memory_order_relaxed);
+            }
+        }
+        return attempts ? (double)rejects / attempts : 0.0;
+    }
+
+private:
+    struct Bucket {
+        std::atomic<int64_t> second;
+        std::atomic<uint64_t> attempts;
+        std::atomic<uint64_t> rejects;
+    };
+    Bucket buckets[SECONDS];
+    std::atomic<int64_t> lastUs{ -1 };
+};
+
+struct LatencySummary {
+    uint64_t count = 0;
+    double p50Ms = 0, p90Ms = 0, p99Ms = 0, maxMs = 0;
+};
+
+struct TelemetrySnapshot {
+    double timeSec = 0;
+    uint64_t submitted = 0;
+    uint64_t rejected = 0;
+    int depth = 0;
+    double avgDepth = 0;
+    double fullSec = 0;
+    double rejectRate1s = 0, rejectRate10s = 0, rejectRate60s = 0;
+    LatencySummary wait;     // від Order::created до початку готування
+    LatencySummary service;  // від початку готування до готовності
+    std::vector<double> busySec; // простій = timeSec - busySec
+};
+
+// Телеметрія конвеєра замовлень. Лічильники черги (подачі, відмови,
+// глибина) змінюються разом під seqlock, тож знімок бачить їх узгодженими;
+// гістограми, ковзні вікна та зайнятість - окремі атомарні без блокувань.
+// Час передає викликач (мікросекунди від старту), тому той самий клас
+// працює і в реальному, і у віртуальному часі.
+class PipelineTelemetry {
+public:
+    PipelineTelemetry(int workers, int queueCapacity) : busyUs(workers) {
+        queue.update([queueCapacity](QueueCounters& q) { q.gauge.cap = queueCapacity; });
+        for (auto& b : busyUs) b.store(0, std::memory_order_relaxed);
+    }
+
+    // Перед спробою push: займає місце в лічильнику глибини, щоб dequeued()
+    // кухаря ніколи не випередило відповідний вхід.
+    void reserve(int64_t nowUs) {
+        queue.update([nowUs](QueueCounters& q) { q.gauge.enter(nowUs); });
+    }
+
+    void submitted(int64_t nowUs) {
+        queue.update([](QueueCounters& q) { q.submits++; });
+        rates.record(nowUs, false);
+    }
+
+    // Відмова повертає місце, зайняте reserve().
+    void rejected(int64_t nowUs) {
+        queue.update([nowUs](QueueCounters& q) {
+            q.rejects++;
+            q.gauge.exit(nowUs);
+            });
+        rates.record(nowUs, true);
+    }
+
+    void dequeued(int64_t nowUs) {
+        queue.update([nowUs](QueueCounters& q) { q.gauge.exit(nowUs); });
+    }
+    void waited(int64_t us) { waitHist.record(us); }
+    void served(int64_t us) { serviceHist.record(us); }
+    void busy(int worker, int64_t us) { busyUs[worker].fetch_add(us, std::memory_order_relaxed); }
+
+    int workers() const { return (int)busyUs.size(); }
+
+    TelemetrySnapshot snapshot(int64_t nowUs) const {
+        TelemetrySnapshot s;
+        s.timeSec = nowUs / 1e6;
+        QueueCounters q = queue.load();
+        s.submitted = q.submits;
+        s.rejected = q.rejects;
+        s.depth = q.gauge.depth();
+        s.avgDepth = q.gauge.average(nowUs);
+        s.fullSec = q.gauge.fullSeconds(nowUs);
+        s.rejectRate1s = rates.rate(nowUs, 1);
+        s.rejectRate10s = rates.rate(nowUs, 10);
+        s.rejectRate60s = rates.rate(nowUs, 60);
+        s.wait = summarize(waitHist);
+        s.service = summarize(serviceHist);
+        for (const auto& b : busyUs) s.busySec.push_back(b.load(std::memory_order_relaxed) / 1e6);
+        return s;
+    }
+
+    // Підсумковий знімок: частки відмов рахуються на момент останньої спроби
+    // подати замовлення, бо після зупинки касирів ковзні вікна вже порожні.
+    TelemetrySnapshot finalSnapshot(int64_t nowUs) const {
+        TelemetrySnapshot s = snapshot(nowUs);
+        int64_t last = rates.last();
+        if (last >= 0) {
+            s.rejectRate1s = rates.rate(last, 1);
+            s.rejectRate10s = rates.rate(last, 10);
+            s.rejectRate60s = rates.rate(last, 60);
+        }
+        return s;
+    }
+
+private:
+    static LatencySummary summarize(const AtomicHistogram& h) {
+        LatencySummary l;
+        l.count = h.count();
+        l.p50Ms = h.percentile(50) / 1000.0;
+        l.p90Ms = h.percentile(90) / 1000.0;
+        l.p99Ms = h.percentile(99) / 1000.0;
+        l.maxMs = h.max() / 1000.0;
+        return l;
+    }
+
+    struct QueueCounters {
+        uint64_t submits = 0, rejects = 0;
+        DepthGauge gauge;
+    };
+
+    Seqlocked<QueueCounters> queue;
+    SlidingRate rates;
+    AtomicHistogram waitHist, serviceHist;
+    std::vector<std::atomic<int64_t>> busyUs;
+};
+
+inline void writeCsvHeader(std::ostream& out, size_t workers) {
+    out << "time_s,submitted,rejected,depth,avg_depth,full_s,reject_rate_1s,reject_rate_10s,reject_rate_60s,"
+        << "wait_p50_ms,wait_p99_ms,service_p50_ms,service_p99_ms";
+    for (size_t i = 0; i < workers; ++i) out << ",busy_" << i << "_s";
+    out << "\n";
+}
+
+inline void writeCsvRow(std::ostream& out, const TelemetrySnapshot& s) {
+    out << s.timeSec << "," << s.submitted << "," << s.rejected << "," << s.depth << ","
+        << s.avgDepth << "," << s.fullSec << ","
+        << s.rejectRate1s << "," << s.rejectRate10s << "," << s.rejectRate60s << ","
+        << s.wait.p50Ms << "," << s.wait.p99Ms << "," << s.service.p50Ms << "," << s.service.p99Ms;
+    for (double b : s.busySec) out << "," << b;
+    out << "\n";
+}
+
+// Фоновий потік, що раз на інтервал дописує знімок у CSV (реальний час).
+class TelemetrySampler {
+public:
+    TelemetrySampler(const PipelineTelemetry& telemetry, std::chrono::steady_clock::time_point start)
+        : telemetry(telemetry), start(start) {}
+
+    ~TelemetrySampler() { stop(); }
+
+    bool begin(const std::string& path, std::chrono::milliseconds interval) {
+        out.open(path);
+        if (!out) return false;
+        writeCsvHeader(out, telemetry.workers());
+        stopping = false;
+        worker = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lock(mtx);
+            while (!cv.wait_for(lock, interval, [this] { return stopping; }))
+                writeCsvRow(out, telemetry.snapshot(nowUs()));
+        });
+        return true;
+    }
+
+    // Дописує останній рядок і закриває файл.
+    void stop() {
+        if (!worker.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_one();
+        worker.join();
+        writeCsvRow(out, telemetry.snapshot(nowUs()));
+        out.close();
+    }
+
+private:
+    int64_t nowUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const PipelineTelemetry& telemetry;
+    std::chrono::steady_clock::time_point start;
+    std::ofstream out;
+    std::thread worker;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+};
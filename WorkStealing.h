@@ -0,0 +1,251 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "MpmcRing.h"
+
+// Двостороння черга Chase-Lev: власник кладе та забирає знизу (LIFO),
+// інші потоки крадуть зверху (FIFO). Масив росте при переповненні,
+// старі масиви звільняються лише в деструкторі, бо злодії можуть їх читати.
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque needs trivially copyable tasks");
+
+public:
+    explicit ChaseLevDeque(size_t capacity = 64) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        arrays.emplace_back(new Array(cap));
+        array.store(arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Тільки потік-власник.
+    void push(const T& value) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > (int64_t)a->mask) a = grow(a, t, b);
+        a->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Тільки потік-власник.
+    bool pop(T& out) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if (t == b) {
+            // останній елемент: змагаємось зі злодіями
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Будь-який потік.
+    bool steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        Array* a = array.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+        out = value;
+        return true;
+    }
+
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Array {
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+        explicit Array(size_t cap) : mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+        T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, const T& v) { slots[i & mask].store(v, std::memory_order_relaxed); }
+    };
+
+    Array* grow(Array* old, int64_t t, int64_t b) {
+        arrays.emplace_back(new Array((old->mask + 1) * 2));
+        Array* a = arrays.back().get();
+        for (int64_t i = t; i < b; ++i) a->put(i, old->get(i));
+        array.store(a, std::memory_order_release);
+        return a;
+    }
+
+    alignas(64) std::atomic<int64_t> top{ 0 };
+    alignas(64) std::atomic<int64_t> bottom{ 0 };
+    std::atomic<Array*> array{ nullptr };
+    std::vector<std::unique_ptr<Array>> arrays; // змінює тільки власник
+};
+
+struct WorkerStats {
+    uint64_t tasks = 0;   // виконано задач
+    uint64_t steals = 0;  // з них вкрадено в інших
+};
+
+// Планувальник з крадіжкою роботи. Зовнішні потоки (касири) подають задачі
+// в обмежену MpmcRing; кожен робітник (кухар) тримає власну дек Chase-Lev,
+// куди обробник може дробити задачу через spawn. Вільний робітник бере
+// свою дек, потім спільну чергу, потім краде у випадкового сусіда,
+// а якщо роботи немає - засинає на std::atomic::wait.
+// Потоки створює викликач і передає кожному run(worker, fn).
+template <typename Task>
+class WorkStealingScheduler {
+public:
+    WorkStealingScheduler(int workers, size_t queueCapacity)
+        : injection(queueCapacity), slots(workers) {
+        for (int i = 0; i < workers; ++i) slots[i].rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+
+    // Неблокуюча подача ззовні; false, якщо черга повна або планувальник зупинено.
+    bool trySubmit(const Task& task) {
+        if (closed.load()) return false;
+        pending.fetch_add(1);
+        if (!injection.try_push(task)) {
+            // робітник міг побачити тимчасове pending > 0 і заснути після shutdown()
+            if (pending.fetch_sub(1) == 1 && closed.load()) wakeAll();
+            return false;
+        }
+        wakeOne();
+        return true;
+    }
+
+    // Дочірня задача; викликається лише з потоку робітника `worker`.
+    void spawn(int worker, const Task& task) {
+        pending.fetch_add(1);
+        slots[worker].deque.push(task);
+        wakeOne();
+    }
+
+    // Цикл робітника: fn(const Task&) для кожної задачі, поки не викличуть
+    // shutdown() і вся подана робота не буде виконана.
+    template <typename Fn>
+    void run(int worker, Fn&& fn) {
+        Slot& self = slots[worker];
+        Task task;
+        while (true) {
+            bool stolen = false;
+            if (!findTask(worker, task, stolen)) {
+                if (finished()) return;
+                park(worker);
+                continue;
+            }
+
+            fn(task);
+
+            self.tasks.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) self.steals.fetch_add(1, std::memory_order_relaxed);
+
+            if (pending.fetch_sub(1) == 1 && closed.load()) wakeAll();
+        }
+    }
+
+    // Нових задач не приймаємо; run() завершиться, коли черги спорожніють.
+    void shutdown() {
+        closed.store(true);
+        injection.close();
+        wakeAll();
+    }
+
+    WorkerStats stats(int worker) const {
+        const Slot& s = slots[worker];
+        WorkerStats st;
+        st.tasks = s.tasks.load(std::memory_order_relaxed);
+        st.steals = s.steals.load(std::memory_order_relaxed);
+        return st;
+    }
+
+    int workers() const { return (int)slots.size(); }
+    size_t queued() const { return injection.size(); }
+    size_t capacity() const { return injection.capacity(); }
+
+private:
+    struct alignas(64) Slot {
+        ChaseLevDeque<Task> deque;
+        uint64_t rng = 1;
+        std::atomic<uint64_t> tasks{ 0 };
+        std::atomic<uint64_t> steals{ 0 };
+    };
+
+    bool findTask(int worker, Task& task, bool& stolen) {
+        Slot& self = slots[worker];
+        if (self.deque.pop(task)) return true;
+        if (injection.try_pop(task)) return true;
+
+        int n = (int)slots.size();
+        if (n > 1) {
+            // xorshift: випадковий перший кандидат, далі по колу
+            self.rng ^= self.rng << 13;
+            self.rng ^= self.rng >> 7;
+            self.rng ^= self.rng << 17;
+            int start = (int)(self.rng % (uint64_t)n);
+            for (int k = 0; k < n; ++k) {
+                int victim = (start + k) % n;
+                if (victim != worker && slots[victim].deque.steal(task)) {
+                    stolen = true;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool finished() const {
+        return closed.load() && pending.load() == 0;
+    }
+
+    bool hasVisibleWork(int worker) const {
+        if (!injection.empty()) return true;
+        for (int i = 0; i < (int)slots.size(); ++i)
+            if (i != worker && !slots[i].deque.empty()) return true;
+        return false;
+    }
+
+    void park(int worker) {
+        sleepers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t epoch = wakeEpoch.load();
+        if (!hasVisibleWork(worker) && !finished())
+            wakeEpoch.wait(epoch);
+        sleepers.fetch_sub(1);
+    }
+
+    void wakeOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) {
+            wakeEpoch.fetch_add(1);
+            wakeEpoch.notify_one();
+        }
+    }
+
+    void wakeAll() {
+        wakeEpoch.fetch_add(1);
+        wakeEpoch.notify_all();
+    }
+
+    MpmcRing<Task> injection;
+    std::vector<Slot> slots;
+    alignas(64) std::atomic<int64_t> pending{ 0 }; // подані, але ще не виконані задачі
+    std::atomic<bool> closed{ false };
+    alignas(64) std::atomic<uint32_t> wakeEpoch{ 0 };
+    std::atomic<int> sleepers{ 0 };
+};
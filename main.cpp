@@ -5,14 +5,14 @@
 #include <cmath>
 #include <chrono>
 #include <thread>
+#include "Reductions.h"
 using namespace std;
 using namespace std::chrono;
 
-void worker(int* arr, int size, int start, int step, double& local_sum) {
-    local_sum = 0;
-    for (int i = start; i < size; i += step) {
-        local_sum += arr[i] * arr[i];
-    }
+// Кожен потік рахує суцільний шматок масиву, а не кожен step-й елемент:
+// так ядро читає пам'ять послідовно і потоки не ділять рядки кешу.
+void worker(const int* arr, size_t begin, size_t end, double& local_sum) {
+    local_sum = reduce::sumSquares(arr + begin, end - begin);
 }
 
 double norm_dynamic_threads(int* arr, int size, int num_threads, double& sum, long long& duration) {
@@ -22,7 +22,9 @@ double norm_dynamic_threads(int* arr, int size, int num_threads, double& sum, lo
     auto start = high_resolution_clock::now();
 
     for (int i = 0; i < num_threads; ++i) {
-        workers[i] = thread(worker, arr, size, i, num_threads, ref(local_sum[i]));
+        size_t begin, end;
+        reduce::chunk(size, num_threads, i, begin, end);
+        workers[i] = thread(worker, arr, begin, end, ref(local_sum[i]));
     }
 
     for (int i = 0; i < num_threads; ++i) {
@@ -48,10 +50,7 @@ double norm_dynamic_threads(int* arr, int size, int num_threads, double& sum, lo
 double norm_slow(int* arr, int size, double& sum, long long& duration) {
     auto start = high_resolution_clock::now();
 
-    sum = 0;
-    for (int i = 0; i < size; i++) {
-        sum += arr[i] * arr[i];
-    }
+    sum = reduce::sumSquares(arr, size);
     double norm = sqrt(sum);
 
     auto end = high_resolution_clock::now();
@@ -60,7 +59,10 @@ double norm_slow(int* arr, int size, double& sum, long long& duration) {
     return norm;
 }
 
-void print_results(int* arr, int size, double (*norm_func)(int*, int, int, double&, long long&), int num_threads, const string& label) {
+// Функція норми - параметр шаблону, а не аргумент-вказівник: кожен
+// виклик print_results отримує власну інстанціацію з прямим викликом.
+template <auto norm_func>
+void print_results(int* arr, int size, int num_threads, const string& label) {
     double sum = 0;
     long long duration = 0;
     double norm;
@@ -105,14 +107,14 @@ int main() {
     cout << string(100, '-') << endl;
 
     for (int i = 0; i < numSizes; i++) {
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 0, "Default");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 1, "1 Thread");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 2, "2 Threads");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 5, "5 Threads");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 10, "10 Threads");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 25, "25 Threads");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 50, "50 Threads");
-        print_results(arrays[i], sizes[i], norm_dynamic_threads, 100, "100 Threads");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 0, "Default");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 1, "1 Thread");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 2, "2 Threads");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 5, "5 Threads");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 10, "10 Threads");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 25, "25 Threads");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 50, "50 Threads");
+        print_results<norm_dynamic_threads>(arrays[i], sizes[i], 100, "100 Threads");
         cout << string(100, '-') << endl;
     }
 